@@ -117,7 +117,7 @@ public:
 
     std::shared_ptr<base::IDataArray> createDataArray(const std::string &name, const std::string &type,
                                                       nix::DataType data_type, const NDSize &shape,
-                                                      const Compression &compression);
+                                                      const Compression &compression, const AccessHint &hint);
 
     //--------------------------------------------------
     // Methods concerning data frames
@@ -126,7 +126,8 @@ public:
     std::shared_ptr<base::IDataFrame> createDataFrame(const std::string &name,
                                                       const std::string &type,
                                                       const std::vector<Column> &cols,
-                                                      const Compression &compression);
+                                                      const Compression &compression,
+                                                      DataFrameLayout layout);
 
 
     //--------------------------------------------------
@@ -240,7 +240,8 @@ bool DataArrayFS::deleteDimensions() {
 DataArrayFS::~DataArrayFS() {
 }
 
-void DataArrayFS::createData(DataType dtype, const NDSize &size, const Compression &compression) {
+void DataArrayFS::createData(DataType dtype, const NDSize &size, const Compression &compression,
+                             const AccessHint &hint) {
     setDtype(dtype);
     dataExtent(size);
     /*
@@ -253,6 +254,17 @@ void DataArrayFS::createData(DataType dtype, const NDSize &size, const Compressi
     */ //FIXME
 }
 
+NDSize DataArrayFS::chunking() const {
+    return NDSize();
+}
+
+void DataArrayFS::chunkCache(const ChunkCache &cache) {
+}
+
+ChunkCache DataArrayFS::chunkCache() const {
+    return ChunkCache();
+}
+
 bool DataArrayFS::hasData() const {
     return hasObject("data");
 }
@@ -301,6 +313,37 @@ void DataArrayFS::read(DataType dtype, void *data, const NDSize &count, const ND
     */
 }
 
+
+void DataArrayFS::readParallel(DataType dtype, void *data, const NDSize &count, const NDSize &offset, size_t threads) const {
+    read(dtype, data, count, offset);
+}
+
+
+void DataArrayFS::writeParallel(DataType dtype, const void *data, const NDSize &count, const NDSize &offset, size_t threads) {
+    write(dtype, data, count, offset);
+}
+
+
+void DataArrayFS::readStrided(DataType dtype, void *data, const NDSize &count, const NDSize &offset,
+                              const NDSize &strides) const {
+    std::vector<char> buffer(count.nelms() * data_type_to_size(dtype));
+    read(dtype, buffer.data(), count, offset);
+    DataSpan(dtype, data, count, strides).scatter(buffer.data());
+}
+
+
+void DataArrayFS::read(DataType dtype, void *data, const std::vector<NDSize> &counts, const std::vector<NDSize> &offsets) const {
+    if (counts.size() != offsets.size()) {
+        throw std::invalid_argument("DataArrayFS::read: number of counts and offsets must match");
+    }
+    char *buffer = static_cast<char *>(data);
+    size_t esize = data_type_to_size(dtype);
+    for (size_t i = 0; i < counts.size(); ++i) {
+        read(dtype, buffer, counts[i], offsets[i]);
+        buffer += counts[i].nelms() * esize;
+    }
+}
+
 NDSize DataArrayFS::dataExtent(void) const {
     if (!hasAttr("extent")) {
         return NDSize{};
@@ -149,7 +149,17 @@ public:
     // Methods concerning data access.
     //--------------------------------------------------
 
-    virtual void createData(DataType dtype, const NDSize &size, const Compression &compression);
+    virtual void createData(DataType dtype, const NDSize &size, const Compression &compression,
+                            const AccessHint &hint);
+
+
+    NDSize chunking() const;
+
+
+    void chunkCache(const ChunkCache &cache);
+
+
+    ChunkCache chunkCache() const;
 
 
     bool hasData() const;
@@ -161,6 +171,18 @@ public:
     void read(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset) const;
 
 
+    void read(DataType dtype, void *buffer, const std::vector<NDSize> &counts, const std::vector<NDSize> &offsets) const;
+
+
+    void readStrided(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset, const NDSize &strides) const;
+
+
+    void readParallel(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset, size_t threads) const;
+
+
+    void writeParallel(DataType dtype, const void *data, const NDSize &count, const NDSize &offset, size_t threads);
+
+
     NDSize dataExtent(void) const;
 
 
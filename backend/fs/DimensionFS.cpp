@@ -8,6 +8,8 @@
 
 #include "DimensionFS.hpp"
 
+#include <algorithm>
+
 using namespace nix::base;
 
 namespace nix {
@@ -466,6 +468,19 @@ void RangeDimensionFS::ticks(const std::vector<double> &ticks) {
     */ //FIXME this needs to implemented once there is a dataset or equivalent in the FS backend
 }
 
+std::shared_ptr<const std::vector<double>> RangeDimensionFS::cachedTicks() const {
+    return std::make_shared<const std::vector<double>>(ticks());
+}
+
+ndsize_t RangeDimensionFS::tickCount() const {
+    return ticks().size();
+}
+
+ndsize_t RangeDimensionFS::lowerBound(double position) const {
+    std::vector<double> t = ticks();
+    return std::lower_bound(t.begin(), t.end(), position) - t.begin();
+}
+
 RangeDimensionFS::~RangeDimensionFS() {}
 
 } // ns nix::file
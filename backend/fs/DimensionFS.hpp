@@ -244,6 +244,15 @@ public:
     void ticks(const std::vector<double> &ticks);
 
 
+    std::shared_ptr<const std::vector<double>> cachedTicks() const;
+
+
+    ndsize_t tickCount() const;
+
+
+    ndsize_t lowerBound(double position) const;
+
+
     virtual ~RangeDimensionFS();
 
 private:
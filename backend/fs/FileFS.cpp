@@ -285,6 +285,10 @@ Compression FileFS::compression() const {
     return compr;
 }
 
+ChunkCache FileFS::chunkCache() const {
+    return ChunkCache();
+}
+
 FileFS::~FileFS() {}
 
 } // namespace file
@@ -123,6 +123,9 @@ public:
     Compression compression() const;
 
 
+    ChunkCache chunkCache() const;
+
+
     bool operator==(const FileFS &other) const;
 
 
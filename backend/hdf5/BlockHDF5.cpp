@@ -19,15 +19,28 @@
 
 #include <boost/range/irange.hpp>
 
+#include <algorithm>
+#include <tuple>
+
 using namespace std;
 using namespace nix::base;
 
 namespace nix {
 namespace hdf5 {
 
+// entity containers inside a block group and the type of their entities
+static const vector<pair<ObjectType, string>> entity_containers = {
+    {ObjectType::DataArray, "data_arrays"},
+    {ObjectType::DataFrame, "data_frames"},
+    {ObjectType::Tag,       "tags"},
+    {ObjectType::MultiTag,  "multi_tags"},
+    {ObjectType::Source,    "sources"},
+    {ObjectType::Group,     "groups"}
+};
+
 
 BlockHDF5::BlockHDF5(const std::shared_ptr<base::IFile> &file, const H5Group &group)
-        : EntityWithMetadataHDF5(file, group), compr(Compression::Auto) {
+        : EntityWithMetadataHDF5(file, group), compr(file->compression()), id_index_loaded(false) {
     data_array_group = this->group().openOptGroup("data_arrays");
     data_frame_group = this->group().openOptGroup("data_frames");
     tag_group = this->group().openOptGroup("tags");
@@ -44,7 +57,7 @@ BlockHDF5::BlockHDF5(const shared_ptr<IFile> &file, const H5Group &group, const
 
 BlockHDF5::BlockHDF5(const shared_ptr<IFile> &file, const H5Group &group, const string &id,
                      const string &type, const string &name, time_t time, const Compression &compression)
-     : EntityWithMetadataHDF5(file, group, id, type, name, time), compr(compression) {
+     : EntityWithMetadataHDF5(file, group, id, type, name, time), compr(compression), id_index_loaded(false) {
     data_array_group = this->group().openOptGroup("data_arrays");
     data_frame_group = this->group().openOptGroup("data_frames");
     tag_group = this->group().openOptGroup("tags");
@@ -93,6 +106,120 @@ boost::optional<H5Group> BlockHDF5::groupForObjectType(ObjectType type, bool cre
     return p;
 }
 
+LinkIndex &BlockHDF5::indexForObjectType(ObjectType type) const {
+    loadIdIndex();
+    return id_index[type];
+}
+
+void BlockHDF5::loadIdIndex() const {
+    if (id_index_loaded) {
+        return;
+    }
+    id_index_loaded = true;
+
+    if (!group().hasGroup("id_index")) {
+        return;
+    }
+
+    H5Group table = group().openGroup("id_index", false);
+    vector<string> ids, names;
+    vector<int> types;
+    if (!table.getData("entity_id", ids) || !table.getData("type", types) ||
+        !table.getData("link_name", names) ||
+        ids.size() != types.size() || ids.size() != names.size()) {
+        return;
+    }
+
+    map<ObjectType, unordered_map<string, string>> entries;
+    for (size_t i = 0; i < ids.size(); i++) {
+        entries[static_cast<ObjectType>(types[i])].emplace(ids[i], names[i]);
+    }
+
+    // the stamps are checked against the containers on every lookup, so a
+    // table that is out of date is simply replaced by a scan
+    for (const auto &c : entity_containers) {
+        vector<int64_t> at;
+        if (!table.getAttr(c.second, at) || at.size() != 2) {
+            continue;
+        }
+
+        LinkIndex::Stamp stamp;
+        stamp.nlinks = static_cast<hsize_t>(at[0]);
+        stamp.max_corder = at[1];
+        id_index[c.first].assign(stamp, std::move(entries[c.first]));
+    }
+}
+
+void BlockHDF5::writeIdIndex(const H5Group &group) {
+    boost::optional<H5Group> table;
+    if (group.hasGroup("id_index")) {
+        table = group.openGroup("id_index", false);
+    }
+
+    struct Container {
+        ObjectType type;
+        string name;
+        H5Group group;
+        LinkIndex::Stamp stamp;
+    };
+
+    bool stale = !table;
+    vector<Container> present;
+
+    for (const auto &c : entity_containers) {
+        if (!group.hasGroup(c.second)) {
+            stale = stale || table->hasAttr(c.second);
+            continue;
+        }
+
+        H5Group container = group.openGroup(c.second, false);
+        LinkIndex::Stamp now = LinkIndex::stamp(container);
+        if (!stale) {
+            vector<int64_t> at;
+            stale = !table->getAttr(c.second, at) || at.size() != 2 ||
+                    static_cast<hsize_t>(at[0]) != now.nlinks || at[1] != now.max_corder;
+        }
+
+        present.push_back({c.first, c.second, container, now});
+    }
+
+    if (!stale) {
+        return;
+    }
+
+    vector<tuple<string, int, string>> rows;
+    for (auto &c : present) {
+        LinkIndex index;
+        for (const auto &e : index.entries(c.group)) {
+            rows.emplace_back(e.first, static_cast<int>(c.type), e.second);
+        }
+    }
+
+    sort(rows.begin(), rows.end());
+
+    vector<string> ids, names;
+    vector<int> types;
+    ids.reserve(rows.size());
+    names.reserve(rows.size());
+    types.reserve(rows.size());
+    for (const auto &r : rows) {
+        ids.push_back(get<0>(r));
+        types.push_back(get<1>(r));
+        names.push_back(get<2>(r));
+    }
+
+    H5Group parent = group;
+    parent.removeGroup("id_index");
+
+    H5Group out = parent.openGroup("id_index", true);
+    out.setData("entity_id", ids);
+    out.setData("type", types);
+    out.setData("link_name", names);
+    for (const auto &c : present) {
+        out.setAttr(c.name, vector<int64_t>{static_cast<int64_t>(c.stamp.nlinks), c.stamp.max_corder});
+    }
+}
+
 boost::optional<H5Group> BlockHDF5::findEntityGroup(const nix::Identity &ident) const {
     boost::optional<H5Group> p = groupForObjectType(ident.type());
 
@@ -117,7 +244,7 @@ boost::optional<H5Group> BlockHDF5::findEntityGroup(const nix::Identity &ident)
     if (foundNeedle) {
         g = boost::make_optional(p->openGroup(needle, false));
     } else if (haveId) {
-        g = p->findGroupByAttribute("entity_id", iid);
+        g = indexForObjectType(ident.type()).findGroup(*p, iid);
     }
 
     if (g && haveName && haveId) {
@@ -242,10 +369,16 @@ bool BlockHDF5::removeEntity(const nix::Identity &ident) {
     }
 
     // we get first "entity" link by name, but delete all others whatever their name with it
-    std::string name;
+    std::string name, eid;
     eg->getAttr("name", name);
+    eg->getAttr("entity_id", eid);
 
-    return p->removeAllLinks(name);
+    bool removed = p->removeAllLinks(name);
+    if (removed) {
+        indexForObjectType(ident.type()).erase(*p, eid);
+    }
+
+    return removed;
 }
 
 
@@ -258,7 +391,9 @@ shared_ptr<ISource> BlockHDF5::createSource(const string &name, const string &ty
     boost::optional<H5Group> g = source_group(true);
 
     H5Group group = g->openGroup(name, true);
-    return make_shared<SourceHDF5>(file(), block(), group, id, type, name);
+    auto source = make_shared<SourceHDF5>(file(), block(), group, id, type, name);
+    indexForObjectType(ObjectType::Source).insert(*g, id, name);
+    return source;
 }
 
 
@@ -278,6 +413,9 @@ bool BlockHDF5::deleteSource(const string &name_or_id) {
             }
             // if hasSource is true then source_group always exists
             deleted = g->removeAllLinks(source.name());
+            if (deleted) {
+                indexForObjectType(ObjectType::Source).erase(*g, source.id());
+            }
         }
     }
 
@@ -296,7 +434,9 @@ shared_ptr<ITag> BlockHDF5::createTag(const std::string &name, const std::string
     boost::optional<H5Group> g = tag_group(true);
 
     H5Group group = g->openGroup(name);
-    return make_shared<TagHDF5>(file(), block(), group, id, type, name, position);
+    auto tag = make_shared<TagHDF5>(file(), block(), group, id, type, name, position);
+    indexForObjectType(ObjectType::Tag).insert(*g, id, name);
+    return tag;
 }
 
 //--------------------------------------------------
@@ -308,15 +448,17 @@ shared_ptr<IDataArray> BlockHDF5::createDataArray(const std::string &name,
                                                   const std::string &type,
                                                   nix::DataType data_type,
                                                   const NDSize &shape,
-                                                  const Compression &compression) {
+                                                  const Compression &compression,
+                                                  const AccessHint &hint) {
     string id = util::createId();
     boost::optional<H5Group> g = data_array_group(true);
 
     H5Group group = g->openGroup(name, true);
     auto da = make_shared<DataArrayHDF5>(file(), block(), group, id, type, name);
+    indexForObjectType(ObjectType::DataArray).insert(*g, id, name);
 
     // now create the actual H5::DataSet
-    da->createData(data_type, shape, compression == Compression::Auto ? compr : compression);
+    da->createData(data_type, shape, compression == Compression::Auto ? compr : compression, hint);
     return da;
 }
 
@@ -327,14 +469,16 @@ shared_ptr<IDataArray> BlockHDF5::createDataArray(const std::string &name,
 std::shared_ptr<IDataFrame> BlockHDF5::createDataFrame(const std::string &name,
                                                        const std::string &type,
                                                        const std::vector<Column> &cols,
-                                                       const Compression &compression) {
+                                                       const Compression &compression,
+                                                       DataFrameLayout layout) {
 
     string id = util::createId();
     boost::optional<H5Group> g = data_frame_group(true);
     H5Group group = g->openGroup(name, true);
 
     auto df = make_shared<DataFrameHDF5>(file(), block(), group, id, type, name);
-    df->createData(cols, compression == Compression::Auto ? compr : compression);
+    indexForObjectType(ObjectType::DataFrame).insert(*g, id, name);
+    df->createData(cols, compression == Compression::Auto ? compr : compression, layout);
     return df;
 }
 
@@ -349,7 +493,9 @@ shared_ptr<IMultiTag> BlockHDF5::createMultiTag(const std::string &name, const s
     boost::optional<H5Group> g = multi_tag_group(true);
 
     H5Group group = g->openGroup(name);
-    return make_shared<MultiTagHDF5>(file(), block(), group, id, type, name, positions);
+    auto tag = make_shared<MultiTagHDF5>(file(), block(), group, id, type, name, positions);
+    indexForObjectType(ObjectType::MultiTag).insert(*g, id, name);
+    return tag;
 }
 
 //--------------------------------------------------
@@ -361,7 +507,9 @@ shared_ptr<IGroup> BlockHDF5::createGroup(const std::string &name, const std::st
     boost::optional<H5Group> g = groups_group(true);
 
     H5Group group = g->openGroup(name);
-    return make_shared<GroupHDF5>(file(), block(), group, id, type, name);
+    auto grp = make_shared<GroupHDF5>(file(), block(), group, id, type, name);
+    indexForObjectType(ObjectType::Group).insert(*g, id, name);
+    return grp;
 }
 
 
@@ -11,7 +11,9 @@
 
 #include <nix/base/IBlock.hpp>
 #include "EntityWithMetadataHDF5.hpp"
+#include "h5x/LinkIndex.hpp"
 
+#include <map>
 #include <vector>
 #include <string>
 #include <boost/optional.hpp>
@@ -29,6 +31,9 @@ private:
 
     optGroup data_array_group, data_frame_group, tag_group, multi_tag_group, source_group, groups_group;
     Compression compr;
+    // entity_id -> link name, per entity container
+    mutable std::map<ObjectType, LinkIndex> id_index;
+    mutable bool id_index_loaded;
 public:
 
     /**
@@ -71,6 +76,10 @@ private:
 
     boost::optional<H5Group> findEntityGroup(const nix::Identity &ident) const;
 
+    LinkIndex &indexForObjectType(ObjectType type) const;
+
+    void loadIdIndex() const;
+
 public:
     //--------------------------------------------------
     // Generic entity methods
@@ -115,7 +124,7 @@ public:
 
     std::shared_ptr<base::IDataArray> createDataArray(const std::string &name, const std::string &type,
                                                       nix::DataType data_type, const NDSize &shape,
-                                                      const Compression &compression);
+                                                      const Compression &compression, const AccessHint &hint);
 
     //--------------------------------------------------
     // Methods concerning DataFrames
@@ -124,7 +133,8 @@ public:
     std::shared_ptr<base::IDataFrame> createDataFrame(const std::string &name,
                                                       const std::string &type,
                                                       const std::vector<Column> &cols,
-                                                      const Compression &compression);
+                                                      const Compression &compression,
+                                                      DataFrameLayout layout);
 
     //--------------------------------------------------
     // Methods concerning tags.
@@ -154,6 +164,16 @@ public:
     //--------------------------------------------------
 
 
+    /**
+     * @brief Write a sorted table of entity_id, type and link name of
+     *        all entities of the block into its "id_index" group, unless
+     *        the table that is there is still up to date.
+     *
+     * @param group     The group that represents the block inside the file.
+     */
+    static void writeIdIndex(const H5Group &group);
+
+
     virtual ~BlockHDF5();
 
 
@@ -10,7 +10,9 @@
 
 #include "DataArrayHDF5.hpp"
 #include "h5x/H5DataSet.hpp"
+#include "h5x/H5PList.hpp"
 #include "DimensionHDF5.hpp"
+#include "FileHDF5.hpp"
 
 using namespace std;
 using namespace nix::base;
@@ -95,19 +97,17 @@ void DataArrayHDF5::unit(const none_t t) {
 
 // TODO use defaults
 boost::optional<double> DataArrayHDF5::expansionOrigin() const {
-    boost::optional<double> ret;
-    double expansion_origin;
-    bool have_attr = group().getAttr("expansion_origin", expansion_origin);
-    if (have_attr) {
-        ret = expansion_origin;
-    }
-    return ret;
+    lock_guard<mutex> lock(data_mutex);
+    loadCalibration();
+    return origin;
 }
 
 
 void DataArrayHDF5::expansionOrigin(double expansion_origin) {
     group().setAttr("expansion_origin", expansion_origin);
     forceUpdatedAt();
+    lock_guard<mutex> lock(data_mutex);
+    calibration_loaded = false;
 }
 
 
@@ -116,18 +116,35 @@ void DataArrayHDF5::expansionOrigin(const none_t t) {
         group().removeAttr("expansion_origin");
     }
     forceUpdatedAt();
+    lock_guard<mutex> lock(data_mutex);
+    calibration_loaded = false;
 }
 
 // TODO use defaults
 vector<double> DataArrayHDF5::polynomCoefficients() const {
-    vector<double> polynom_coefficients;
+    lock_guard<mutex> lock(data_mutex);
+    loadCalibration();
+    return coefficients;
+}
+
 
+void DataArrayHDF5::loadCalibration() const {
+    if (calibration_loaded) {
+        return;
+    }
+
+    double expansion_origin;
+    origin = boost::none;
+    if (group().getAttr("expansion_origin", expansion_origin)) {
+        origin = expansion_origin;
+    }
+
+    coefficients.clear();
     if (group().hasData("polynom_coefficients")) {
         DataSet ds = group().openData("polynom_coefficients");
-        ds.read(polynom_coefficients, true);
+        ds.read(coefficients, true);
     }
-
-    return polynom_coefficients;
+    calibration_loaded = true;
 }
 
 
@@ -141,6 +158,8 @@ void DataArrayHDF5::polynomCoefficients(const vector<double> &coefficients, cons
     }
     ds.write(coefficients);
     forceUpdatedAt();
+    lock_guard<mutex> lock(data_mutex);
+    calibration_loaded = false;
 }
 
 
@@ -149,6 +168,8 @@ void DataArrayHDF5::polynomCoefficients(const none_t t) {
         group().removeData("polynom_coefficients");
     }
     forceUpdatedAt();
+    lock_guard<mutex> lock(data_mutex);
+    calibration_loaded = false;
 }
 
 //--------------------------------------------------
@@ -174,7 +195,7 @@ shared_ptr<IDimension> DataArrayHDF5::getDimension(ndsize_t index) const {
         string str_id = util::numToStr(index);
         if (g->hasGroup(str_id)) {
             H5Group group = g->openGroup(str_id, false);
-            dim = openDimensionHDF5(group, index);
+            dim = openDimensionHDF5(group, index, file());
         }
     }
 
@@ -196,7 +217,7 @@ std::shared_ptr<base::IRangeDimension> DataArrayHDF5::createRangeDimension(ndsiz
 
 std::shared_ptr<base::IRangeDimension> DataArrayHDF5::createAliasRangeDimension() {
     H5Group g = createDimensionGroup(1);
-    return make_shared<RangeDimensionHDF5>(g, 1, *this);
+    return make_shared<RangeDimensionHDF5>(g, 1, file(), *this);
 }
 
 
@@ -255,26 +276,135 @@ bool DataArrayHDF5::deleteDimensions() {
 DataArrayHDF5::~DataArrayHDF5() {
 }
 
-void DataArrayHDF5::createData(DataType dtype, const NDSize &size, const Compression &compression) {
+// the chunk cache HDF5 uses for an open data set
+static ChunkCache applied_cache(const DataSet &ds) {
+    H5Object dapl = H5Dget_access_plist(ds.h5id());
+    dapl.check("DataArrayHDF5: H5Dget_access_plist failed");
+    size_t slots, bytes;
+    double w0;
+    HErr res = H5Pget_chunk_cache(dapl.h5id(), &slots, &bytes, &w0);
+    res.check("DataArrayHDF5: H5Pget_chunk_cache failed");
+    return ChunkCache::fixed(bytes, slots, w0);
+}
+
+void DataArrayHDF5::createData(DataType dtype, const NDSize &size, const Compression &compression,
+                               const AccessHint &hint) {
     if (group().hasData("data")) {
         throw ConsistencyError("DataArray's hdf5 data group already exists!");
     }
 
     h5x::DataType fileType = data_type_to_h5_filetype(dtype);
-    group().createData("data", fileType, size, compression);
+    NDSize chunks = size ? DataSet::chooseChunking(size, fileType.size(), hint) : NDSize();
+    DataSet ds = group().createData("data", fileType, size, compression, {}, chunks);
+
+    lock_guard<mutex> lock(data_mutex);
+    data_set = ds;
+    data_set_addr = FileHDF5::objectAddress(ds);
+    data_set_request = ChunkCache();
+    data_set_cache = applied_cache(ds);
+    data_type = dtype;
+}
+
+NDSize DataArrayHDF5::chunking() const {
+    DataSet ds = openDataSet();
+    return ds.isValid() ? ds.chunking() : NDSize();
+}
+
+void DataArrayHDF5::chunkCache(const ChunkCache &cache) {
+    this->cache = cache;
+}
+
+ChunkCache DataArrayHDF5::chunkCache() const {
+    return cache ? *cache : file()->chunkCache();
+}
+
+DataSet DataArrayHDF5::openDataSet(const NDSize &count, const NDSize &offset) const {
+    ChunkCache config = chunkCache();
+    lock_guard<mutex> lock(data_mutex);
+
+    if (!data_set.isValid()) {
+        if (!group().hasData("data")) {
+            return DataSet();
+        }
+        data_set = group().openData("data");
+        data_set_addr = FileHDF5::objectAddress(data_set);
+        data_set_request = ChunkCache();
+        data_set_cache = applied_cache(data_set);
+    }
+
+    if (config.mode == ChunkCache::Mode::Default) {
+        if (data_set_request.mode == ChunkCache::Mode::Default) {
+            return data_set;
+        }
+    } else {
+        if (element_size == 0) {
+            chunk_shape = data_set.chunking();
+            element_size = data_set.dataType().size();
+        }
+        if (!chunk_shape || (config.mode == ChunkCache::Mode::Auto && !count)) {
+            return data_set;
+        }
+
+        // an automatic cache only grows, reopening it for smaller accesses would drop the chunks
+        bool automatic = config.mode == ChunkCache::Mode::Auto;
+        config = DataSet::sizeChunkCache(config, chunk_shape, element_size, count, offset);
+        // compared with the request, so that a cache HDF5 did not apply is not asked for again
+        const ChunkCache &open = data_set_request;
+        if (open.mode != ChunkCache::Mode::Default && open.w0 == config.w0 &&
+            (automatic ? open.bytes >= config.bytes : open.bytes == config.bytes && open.slots == config.slots)) {
+            return data_set;
+        }
+    }
+
+    // HDF5 only applies the access properties when the data set is not open yet,
+    // not if another handle keeps it open
+    data_set.close();
+    PList dapl = PList::create(H5P_DATASET_ACCESS);
+    if (config.mode != ChunkCache::Mode::Default) {
+        HErr res = H5Pset_chunk_cache(dapl.h5id(), config.slots, config.bytes, config.w0);
+        res.check("DataArrayHDF5::openDataSet(): H5Pset_chunk_cache failed");
+    }
+    data_set = group().openData("data", dapl.h5id());
+    data_set_request = config;
+    data_set_cache = applied_cache(data_set);
+    return data_set;
+}
+
+ChunkCache DataArrayHDF5::appliedChunkCache() const {
+    openDataSet();
+    lock_guard<mutex> lock(data_mutex);
+    return data_set.isValid() ? data_set_cache : ChunkCache();
+}
+
+boost::optional<NDSize> DataArrayHDF5::logicalExtent() const {
+    shared_ptr<FileHDF5> f = dynamic_pointer_cast<FileHDF5>(file());
+    lock_guard<mutex> lock(data_mutex);
+    return f ? f->logicalExtent(data_set_addr) : boost::none;
+}
+
+void DataArrayHDF5::checkExtent(const NDSize &count, const NDSize &offset) const {
+    boost::optional<NDSize> logical = logicalExtent();
+    if (!logical || count.size() != logical->size() || (offset && offset.size() != logical->size())) {
+        return;
+    }
+    for (size_t d = 0; d < count.size(); ++d) {
+        if ((offset ? offset[d] : 0) + count[d] > (*logical)[d]) {
+            throw OutOfBounds("DataArrayHDF5: access exceeds the extent of the data");
+        }
+    }
 }
 
 bool DataArrayHDF5::hasData() const {
-    return group().hasData("data");
+    return openDataSet().isValid();
 }
 
 void DataArrayHDF5::write(DataType dtype, const void *data, const NDSize &count, const NDSize &offset) {
 
-    if (!group().hasData("data")) {
+    DataSet ds = openDataSet(count, offset);
+    if (!ds.isValid()) {
         throw ConsistencyError("DataArray with missing h5df DataSet");
     }
-
-    DataSet ds = group().openData("data");
+    checkExtent(count, offset);
     h5x::DataType memType = data_type_to_h5_memtype(dtype);
 
     DataSpace fileSpace, memSpace;
@@ -289,11 +419,11 @@ void DataArrayHDF5::write(DataType dtype, const void *data, const NDSize &count,
 }
 
 void DataArrayHDF5::read(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const {
-    if (!group().hasData("data")) {
+    DataSet ds = openDataSet(count, offset);
+    if (!ds.isValid()) {
         throw ConsistencyError("DataArray with missing h5df DataSet");
     }
-
-    DataSet ds = group().openData("data");
+    checkExtent(count, offset);
     h5x::DataType memType = data_type_to_h5_memtype(dtype);
     DataSpace fileSpace, memSpace;
     std::tie(memSpace, fileSpace) = ds.offsetCount2DataSpaces(count, offset);
@@ -308,32 +438,180 @@ void DataArrayHDF5::read(DataType dtype, void *data, const NDSize &count, const
     }
 }
 
+void DataArrayHDF5::readParallel(DataType dtype, void *data, const NDSize &count, const NDSize &offset, size_t threads) const {
+    if (dtype == DataType::String) {
+        read(dtype, data, count, offset);
+        return;
+    }
+    DataSet ds = openDataSet(count, offset);
+    if (!ds.isValid()) {
+        throw ConsistencyError("DataArray with missing h5df DataSet");
+    }
+    checkExtent(count, offset);
+    h5x::DataType memType = data_type_to_h5_memtype(dtype);
+    ds.readParallel(data, memType, count, offset, threads);
+}
+
+void DataArrayHDF5::writeParallel(DataType dtype, const void *data, const NDSize &count, const NDSize &offset, size_t threads) {
+    if (dtype == DataType::String) {
+        write(dtype, data, count, offset);
+        return;
+    }
+    DataSet ds = openDataSet(count, offset);
+    if (!ds.isValid()) {
+        throw ConsistencyError("DataArray with missing h5df DataSet");
+    }
+    checkExtent(count, offset);
+    h5x::DataType memType = data_type_to_h5_memtype(dtype);
+    ds.writeParallel(data, memType, count, offset, threads);
+}
+
+void DataArrayHDF5::read(DataType dtype, void *data, const std::vector<NDSize> &counts, const std::vector<NDSize> &offsets) const {
+    if (counts.size() != offsets.size()) {
+        throw std::invalid_argument("DataArrayHDF5::read: number of counts and offsets must match");
+    }
+    if (dtype == DataType::String) {
+        throw std::invalid_argument("DataArrayHDF5::read: reading several slabs is not supported for strings");
+    }
+    if (counts.empty()) {
+        return;
+    }
+
+    // HDF5 visits every chunk once per read, the cache only needs to hold the largest slab
+    size_t largest = 0;
+    for (size_t i = 1; i < counts.size(); ++i) {
+        if (counts[i].nelms() > counts[largest].nelms()) {
+            largest = i;
+        }
+    }
+    DataSet ds = openDataSet(counts[largest], offsets[largest]);
+    if (!ds.isValid()) {
+        throw ConsistencyError("DataArray with missing h5df DataSet");
+    }
+    for (size_t i = 0; i < counts.size(); ++i) {
+        checkExtent(counts[i], offsets[i]);
+    }
+    h5x::DataType memType = data_type_to_h5_memtype(dtype);
+
+    // one selection for all slabs, HDF5 delivers the union in storage order
+    DataSpace fileSpace = ds.getSpace();
+    ndsize_t nelms = 0;
+    for (size_t i = 0; i < counts.size(); ++i) {
+        fileSpace.hyperslab(counts[i], offsets[i], i == 0 ? H5S_SELECT_SET : H5S_SELECT_OR);
+        nelms += counts[i].nelms();
+    }
+    if (H5Sget_select_npoints(fileSpace.h5id()) != static_cast<hssize_t>(nelms)) {
+        throw std::invalid_argument("DataArrayHDF5::read: slabs must not overlap");
+    }
+    DataSpace memSpace = DataSpace::create(NDSize{nelms}, false);
+
+    ds.read(data, memType, memSpace, fileSpace);
+}
+
+void DataArrayHDF5::readStrided(DataType dtype, void *data, const NDSize &count, const NDSize &offset,
+                                const NDSize &strides) const {
+    DataSet ds = openDataSet(count, offset);
+    if (!ds.isValid()) {
+        throw ConsistencyError("DataArray with missing h5df DataSet");
+    }
+    checkExtent(count, offset);
+    if (count.nelms() == 0) {
+        return;
+    }
+
+    // describe the memory as nested dimensions: only the innermost one is
+    // strided, every other one is as long as the stride of the dimension
+    // before it, in units of its own stride
+    const size_t rank = count.size();
+    NDSize dims(rank, 1), step(rank, 1), start(rank, 0);
+    step[rank - 1] = strides[rank - 1];
+    dims[0] = (count[0] - 1) * step[0] + 1;
+    for (size_t d = 1; d < rank; ++d) {
+        dims[d] = strides[d - 1] / (d + 1 < rank ? strides[d] : 1);
+    }
+    DataSpace memSpace = DataSpace::create(dims, false);
+    memSpace.hyperslab(count, start, step);
+
+    DataSpace fileSpace = ds.getSpace();
+    fileSpace.hyperslab(count, offset);
+    h5x::DataType memType = data_type_to_h5_memtype(dtype);
+    ds.read(data, memType, memSpace, fileSpace);
+}
+
 NDSize DataArrayHDF5::dataExtent(void) const {
-    if (!group().hasData("data")) {
+    DataSet ds = openDataSet();
+    if (!ds.isValid()) {
         return NDSize{};
     }
 
-    DataSet ds = group().openData("data");
-    return ds.size();
+    boost::optional<NDSize> logical = logicalExtent();
+    return logical ? *logical : ds.size();
 }
 
 void DataArrayHDF5::dataExtent(const NDSize &extent) {
-    if (!group().hasData("data")) {
+    DataSet ds = openDataSet();
+    if (!ds.isValid()) {
         throw runtime_error("Data field not found in DataArray!");
     }
 
-    DataSet ds = group().openData("data");
-    ds.setExtent(extent);
+    shared_ptr<FileHDF5> f = dynamic_pointer_cast<FileHDF5>(file());
+    if (!f || !f->growExtents()) {
+        ds.setExtent(extent);
+        return;
+    }
+
+    NDSize physical = ds.size();
+    boost::optional<NDSize> tracked = logicalExtent();
+    NDSize logical = tracked ? *tracked : physical;
+
+    // only growth along a single axis is over-allocated, everything else is done as requested
+    size_t axis = extent.size();
+    size_t changed = 0;
+    bool shrinks = extent.size() != logical.size();
+    for (size_t d = 0; d < extent.size() && !shrinks; ++d) {
+        if (extent[d] != logical[d]) {
+            axis = d;
+            changed++;
+            shrinks = extent[d] < logical[d];
+        }
+    }
+    if (changed == 0 && !shrinks) {
+        return;
+    }
+    for (size_t d = 0; d < extent.size() && !shrinks; ++d) {
+        shrinks = d != axis && physical[d] != extent[d];
+    }
+    if (shrinks || changed > 1) {
+        ds.setExtent(extent);
+        f->logicalExtent(data_set_addr, ds, NDSize());
+        return;
+    }
+
+    if (extent[axis] > physical[axis]) {
+        // double the capacity, rounded up to whole chunks
+        NDSize capacity = extent;
+        capacity[axis] = std::max(extent[axis], physical[axis] * 2);
+        NDSize chunks = ds.chunking();
+        if (chunks) {
+            capacity[axis] = (capacity[axis] + chunks[axis] - 1) / chunks[axis] * chunks[axis];
+        }
+        ds.setExtent(capacity);
+    }
+    f->logicalExtent(data_set_addr, ds, extent);
 }
 
 DataType DataArrayHDF5::dataType(void) const {
-    if (!group().hasData("data")) {
+    DataSet ds = openDataSet();
+    if (!ds.isValid()) {
         return DataType::Nothing;
     }
 
-    DataSet ds = group().openData("data");
-    const h5x::DataType dtype = ds.dataType();
-    return data_type_from_h5(dtype);
+    // the type of the data can not change, so it is only read once
+    lock_guard<mutex> lock(data_mutex);
+    if (data_type == DataType::Nothing) {
+        data_type = data_type_from_h5(ds.dataType());
+    }
+    return data_type;
 }
 
 } // ns nix::hdf5
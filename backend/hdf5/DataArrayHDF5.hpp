@@ -20,6 +20,8 @@
 
 #include <boost/multi_array.hpp>
 
+#include <mutex>
+
 namespace nix {
 namespace hdf5 {
 
@@ -33,6 +35,34 @@ private:
 
     optGroup dimension_group;
 
+    boost::optional<ChunkCache> cache;
+    // chunk shape and element size of the data, needed to size the cache
+    mutable NDSize chunk_shape;
+    mutable size_t element_size = 0;
+
+    // the open data set and what every read needs, filled on first use;
+    // the calibration is dropped when it is written through this object
+    mutable std::mutex data_mutex;
+    mutable DataSet data_set;
+    // the cache last asked for when opening the data set, and the one HDF5
+    // applied, which differ if another handle kept the data set open
+    mutable ChunkCache data_set_request;
+    mutable ChunkCache data_set_cache;
+    // the object address of the data set, the key of its logical extent in the file
+    mutable haddr_t data_set_addr = HADDR_UNDEF;
+    mutable DataType data_type = DataType::Nothing;
+    mutable bool calibration_loaded = false;
+    mutable std::vector<double> coefficients;
+    mutable boost::optional<double> origin;
+
+    /**
+     * The open data set, with the chunk cache configured for accessing the
+     * given box. Invalid if the DataArray has no data.
+     */
+    DataSet openDataSet(const NDSize &count = {}, const NDSize &offset = {}) const;
+
+    void loadCalibration() const;
+
 public:
 
     /**
@@ -135,7 +165,24 @@ public:
     // Methods concerning data access.
     //--------------------------------------------------
 
-    virtual void createData(DataType dtype, const NDSize &size, const Compression &compression);
+    virtual void createData(DataType dtype, const NDSize &size, const Compression &compression,
+                            const AccessHint &hint);
+
+
+    NDSize chunking() const;
+
+
+    void chunkCache(const ChunkCache &cache);
+
+
+    ChunkCache chunkCache() const;
+
+    /**
+     * @brief The chunk cache HDF5 uses for the open data set, as fixed
+     *        values. HDF5 only applies a cache when the data set is not
+     *        open already, so with several handles the first one wins.
+     */
+    ChunkCache appliedChunkCache() const;
 
 
     bool hasData() const;
@@ -147,6 +194,18 @@ public:
     void read(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset) const;
 
 
+    void read(DataType dtype, void *buffer, const std::vector<NDSize> &counts, const std::vector<NDSize> &offsets) const;
+
+
+    void readStrided(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset, const NDSize &strides) const;
+
+
+    void readParallel(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset, size_t threads) const;
+
+
+    void writeParallel(DataType dtype, const void *data, const NDSize &count, const NDSize &offset, size_t threads);
+
+
     NDSize dataExtent(void) const;
 
 
@@ -159,6 +218,12 @@ private:
 
     // small helper for handling dimension groups
     H5Group createDimensionGroup(ndsize_t index);
+
+    // the logical extent of the open data set if it is over-allocated
+    boost::optional<NDSize> logicalExtent() const;
+
+    // over-allocated data sets are larger than their data, so HDF5 can not check the bounds
+    void checkExtent(const NDSize &count, const NDSize &offset) const;
 };
 
 
@@ -12,9 +12,11 @@
 #include <nix/Compression.hpp>
 
 #include "DataFrameHDF5.hpp"
+#include "FileHDF5.hpp"
 
 #include "h5x/H5DataSet.hpp"
 
+#include <cmath>
 #include <cstring>
 #include <numeric>
 #include <algorithm>
@@ -24,7 +26,7 @@ namespace hdf5 {
 
 
 DataFrameHDF5::DataFrameHDF5(const std::shared_ptr<base::IFile> &file, const std::shared_ptr<base::IBlock> &block, const H5Group &group)
-        : EntityWithSourcesHDF5(file, block, group) {
+        : EntityWithSourcesHDF5(file, block, group), columnar_layout(group.hasGroup("columns")) {
 }
 
 
@@ -34,15 +36,35 @@ DataFrameHDF5::DataFrameHDF5(const std::shared_ptr<base::IFile> &file, const std
 
 
 DataFrameHDF5::DataFrameHDF5(const std::shared_ptr<base::IFile> &file, const std::shared_ptr<base::IBlock> &block, const H5Group &group, const std::string &id, const std::string &type, const std::string &name, time_t time)
-    : EntityWithSourcesHDF5(file, block, group, id, type, name, time) {
+    : EntityWithSourcesHDF5(file, block, group, id, type, name, time), columnar_layout(false) {
 }
 
-void DataFrameHDF5::createData(const std::vector<Column> &cols, const Compression &compression) {
+void DataFrameHDF5::createData(const std::vector<Column> &cols, const Compression &compression,
+                               DataFrameLayout layout) {
 
-    if (group().hasData("data")) {
+    if (group().hasData("data") || group().hasGroup("columns")) {
         throw ConsistencyError("DataFrame's hdf5 data group already exists!");
     }
 
+    std::vector<std::string> names(cols.size());
+    std::vector<std::string> units(cols.size());
+    for (size_t i = 0; i < cols.size(); i++) {
+        names[i] = cols[i].name;
+        units[i] = cols[i].unit;
+    }
+
+    if (layout == DataFrameLayout::Columns) {
+        // the data sets are named by column index, column names need not be valid link names
+        H5Group cg = group().openGroup("columns", true);
+        for (size_t i = 0; i < cols.size(); i++) {
+            cg.createData(std::to_string(i), data_type_to_h5_filetype(cols[i].dtype), {0}, compression);
+        }
+        cg.setAttr("names", names);
+        cg.setAttr("units", units);
+        columnar_layout = true;
+        return;
+    }
+
     std::vector<size_t> offset(cols.size());
     std::vector<h5x::DataType> dtypes(cols.size());
 
@@ -61,15 +83,73 @@ void DataFrameHDF5::createData(const std::vector<Column> &cols, const Compressio
     }
 
     DataSet ds = group().createData("data", ct, {0}, compression);
+    ds.setAttr("units", units);
+}
 
-    std::vector<std::string> units(cols.size());
+DataFrameLayout DataFrameHDF5::layout() const {
+    return columnar() ? DataFrameLayout::Columns : DataFrameLayout::Rows;
+}
 
-    s = 0;
-    std::generate(units.begin(), units.end(), [&s, &cols]{ return cols[s++].unit; });
-    ds.setAttr("units", units);
+std::vector<std::string> DataFrameHDF5::columnNames() const {
+    if (!columnar()) {
+        return data().dataType().member_names();
+    }
+
+    std::vector<std::string> names;
+    group().openGroup("columns", false).getAttr("names", names);
+    return names;
+}
+
+static unsigned column_index(const std::vector<std::string> &names, const std::string &name) {
+    auto it = std::find(names.cbegin(), names.cend(), name);
+    if (it == names.cend()) {
+        throw std::invalid_argument("DataFrame: unknown column " + name);
+    }
+    return static_cast<unsigned>(it - names.cbegin());
+}
+
+static const std::string &column_name(const std::vector<std::string> &names, unsigned col) {
+    if (col >= names.size()) {
+        throw OutOfBounds("DataFrame: column index out of bounds");
+    }
+    return names[col];
+}
+
+DataSet DataFrameHDF5::columnData(unsigned col) const {
+    H5Group cg = group().openGroup("columns", false);
+    const std::string link = std::to_string(col);
+    if (!cg.hasData(link)) {
+        throw OutOfBounds("DataFrame: column index out of bounds");
+    }
+    return cg.openData(link);
+}
+
+DataSet DataFrameHDF5::columnData(const std::string &name) const {
+    return columnData(column_index(columnNames(), name));
+}
+
+DataType DataFrameHDF5::columnType(const std::string &name) const {
+    if (columnar()) {
+        return data_type_from_h5(columnData(name).dataType());
+    }
+    return data_type_from_h5(data().dataType().member_type(name));
 }
 
 std::vector<Column> DataFrameHDF5::columns() const {
+    if (columnar()) {
+        std::vector<std::string> names = columnNames();
+        std::vector<std::string> units(names.size());
+        group().openGroup("columns", false).getAttr("units", units);
+
+        std::vector<Column> cols(names.size());
+        for (size_t i = 0; i < names.size(); i++) {
+            cols[i].dtype = data_type_from_h5(columnData(static_cast<unsigned>(i)).dataType());
+            cols[i].name = names[i];
+            cols[i].unit = units[i];
+        }
+        return cols;
+    }
+
     DataSet ds = data();
     h5x::DataType dt = ds.dataType();
 
@@ -89,18 +169,35 @@ std::vector<Column> DataFrameHDF5::columns() const {
 }
 
 unsigned DataFrameHDF5::colIndex(const std::string &name) const {
+    if (columnar()) {
+        return column_index(columnNames(), name);
+    }
+
     DataSet ds = data();
     h5x::DataType dtype = ds.dataType();
     return dtype.member_index(name);
 }
 
 std::string DataFrameHDF5::colName(unsigned col) const {
+    if (columnar()) {
+        return column_name(columnNames(), col);
+    }
+
     DataSet ds = data();
     h5x::DataType dtype = ds.dataType();
     return dtype.member_name(col);
 }
 
 std::vector<unsigned> DataFrameHDF5::colIndex(const std::vector<std::string> &names) const {
+    if (columnar()) {
+        const std::vector<std::string> all = columnNames();
+        std::vector<unsigned> cols(names.size());
+        for (size_t i = 0; i < names.size(); i++) {
+            cols[i] = column_index(all, names[i]);
+        }
+        return cols;
+    }
+
     DataSet ds = data();
     h5x::DataType dtype = ds.dataType();
 
@@ -114,6 +211,15 @@ std::vector<unsigned> DataFrameHDF5::colIndex(const std::vector<std::string> &na
 }
 
 std::vector<std::string> DataFrameHDF5::colName(const std::vector<unsigned> &cols) const {
+    if (columnar()) {
+        const std::vector<std::string> all = columnNames();
+        std::vector<std::string> names(cols.size());
+        for (size_t i = 0; i < cols.size(); i++) {
+            names[i] = column_name(all, cols[i]);
+        }
+        return names;
+    }
+
     DataSet ds = data();
     h5x::DataType dtype = ds.dataType();
 
@@ -126,15 +232,184 @@ std::vector<std::string> DataFrameHDF5::colName(const std::vector<unsigned> &col
     return names;
 }
 
+static ndsize_t logical_rows(const std::shared_ptr<FileHDF5> &f, const DataSet &ds) {
+    boost::optional<NDSize> logical = f ? f->logicalExtent(ds) : boost::none;
+    NDSize s = logical ? *logical : ds.size();
+    return s.size() > 0 ? s[0] : 0;
+}
+
 ndsize_t DataFrameHDF5::rows() const {
+    if (columnar()) {
+        // all columns have the same number of rows
+        std::vector<std::string> names = columnNames();
+        if (names.empty()) {
+            return 0;
+        }
+        return logical_rows(std::dynamic_pointer_cast<FileHDF5>(file()), columnData(0u));
+    }
+
     DataSet ds = data();
-    NDSize s = ds.size();
-    return s.size() > 0 ? s[0] : 0;
+    return logical_rows(std::dynamic_pointer_cast<FileHDF5>(file()), ds);
 }
 
 void DataFrameHDF5::rows(ndsize_t n) {
-    DataSet ds = data();
-    ds.setExtent({n});
+    std::shared_ptr<FileHDF5> f = std::dynamic_pointer_cast<FileHDF5>(file());
+    const ndsize_t old = rows();
+    if (columnar()) {
+        const size_t count = columnNames().size();
+        for (size_t i = 0; i < count; i++) {
+            DataSet ds = columnData(static_cast<unsigned>(i));
+            resize(ds, n, f && f->growExtents());
+        }
+    } else {
+        DataSet ds = data();
+        resize(ds, n, f && f->growExtents());
+    }
+
+    if (n > old) {
+        appendToIndexes(old, n - old);
+    } else if (n < old) {
+        invalidateIndexes();
+    }
+}
+
+void DataFrameHDF5::checkRows(ndsize_t offset, ndsize_t count) const {
+    const ndsize_t n = rows();
+    if (offset > n || count > n - offset) {
+        throw OutOfBounds("DataFrame: rows out of bounds");
+    }
+}
+
+void DataFrameHDF5::resize(DataSet &ds, ndsize_t n, bool over_allocate) {
+    std::shared_ptr<FileHDF5> f = std::dynamic_pointer_cast<FileHDF5>(file());
+    if (!f) {
+        ds.setExtent({n});
+        return;
+    }
+
+    const ndsize_t physical = ds.size()[0];
+    const bool tracked = !!f->logicalExtent(ds);
+    const ndsize_t logical = logical_rows(f, ds);
+    if (n == logical) {
+        return;
+    }
+
+    if (n > logical && n <= physical) {
+        // already reserved, only contains fill values
+        f->logicalExtent(ds, {n});
+    } else if (n > physical && over_allocate) {
+        // double the capacity, rounded up to whole chunks
+        ndsize_t capacity = std::max(n, physical * 2);
+        NDSize chunks = ds.chunking();
+        if (chunks) {
+            capacity = (capacity + chunks[0] - 1) / chunks[0] * chunks[0];
+        }
+        ds.setExtent({capacity});
+        f->logicalExtent(ds, {n});
+    } else {
+        ds.setExtent({n});
+        if (tracked) {
+            f->logicalExtent(ds, NDSize());
+        }
+    }
+}
+
+static void copy_value(char *mem, const Variant &v) {
+    switch (v.type()) {
+    case DataType::Bool:
+        bool b;
+        v.get(b);
+        std::memcpy(mem, &b, sizeof(b));
+        break;
+
+    case DataType::Double:
+        double d;
+        v.get(d);
+        std::memcpy(mem, &d, sizeof(d));
+        break;
+
+    case DataType::UInt32:
+        uint32_t ui32;
+        v.get(ui32);
+        std::memcpy(mem, &ui32, sizeof(ui32));
+        break;
+
+    case DataType::Int32:
+        int32_t i32;
+        v.get(i32);
+        std::memcpy(mem, &i32, sizeof(i32));
+        break;
+
+    case DataType::UInt64:
+        uint64_t ui64;
+        v.get(ui64);
+        std::memcpy(mem, &ui64, sizeof(ui64));
+        break;
+
+    case DataType::Int64:
+        int64_t i64;
+        v.get(i64);
+        std::memcpy(mem, &i64, sizeof(i64));
+        break;
+
+    case DataType::String:
+        const char *str;
+        str = v.get<const char *>();
+        std::memcpy(mem, &str, sizeof(str));
+        break;
+
+    default:
+        throw std::invalid_argument("Unhandled DataType");
+    };
+}
+
+static void copy_data(Variant &v, const char *mem, DataType data_type) {
+    switch (data_type) {
+    case DataType::Bool:
+        bool b;
+        std::memcpy(&b, mem, sizeof(b));
+        v.set(b);
+        break;
+
+    case DataType::Double:
+        double d;
+        std::memcpy(&d, mem, sizeof(d));
+        v.set(d);
+        break;
+
+    case DataType::UInt32:
+        uint32_t ui32;
+        std::memcpy(&ui32, mem, sizeof(ui32));
+        v.set(ui32);
+        break;
+
+    case DataType::Int32:
+        int32_t i32;
+        std::memcpy(&i32, mem, sizeof(i32));
+        v.set(i32);
+        break;
+
+    case DataType::UInt64:
+        uint64_t ui64;
+        std::memcpy(&ui64, mem, sizeof(ui64));
+        v.set(ui64);
+        break;
+
+    case DataType::Int64:
+        int64_t i64;
+        std::memcpy(&i64, mem, sizeof(i64));
+        v.set(i64);
+        break;
+
+    case DataType::String:
+        const char *str;
+        std::memcpy(&str, mem, sizeof(str));
+        v.set(str);
+        break;
+
+    default:
+        throw std::invalid_argument("Unhandled DataType");
+    };
 }
 
 struct Janus {
@@ -178,6 +453,33 @@ struct Janus {
         }
     }
 
+    explicit Janus(const h5x::DataType &dst, const std::vector<std::vector<Variant>> &rows, size_t first, size_t n) {
+
+        const std::vector<Variant> &head = rows[first];
+        std::vector<size_t> offsets(head.size());
+
+        size_t ms = 0;
+        for (size_t i = 0; i < head.size(); i++) {
+            offsets[i] = ms;
+            ms += data_type_to_h5_memtype(head[i].type()).size();
+        }
+
+        data = new char[ms * n];
+        dtype = h5x::DataType::makeCompound(ms);
+
+        for (size_t i = 0; i < head.size(); i++) {
+            const unsigned k = static_cast<unsigned>(i);
+            dtype.insert(dst.member_name(k), offsets[i], data_type_to_h5_memtype(head[i].type()));
+        }
+
+        for (size_t r = 0; r < n; r++) {
+            const std::vector<Variant> &row = rows[first + r];
+            for (size_t i = 0; i < row.size(); i++) {
+                copyValue(r * ms + offsets[i], row[i]);
+            }
+        }
+    }
+
     explicit Janus(const h5x::DataType &dst, const std::vector<std::string> &cols) {
 
         std::vector<h5x::DataType> dtypes(cols.size());
@@ -207,105 +509,11 @@ struct Janus {
     }
 
     void copyValue(size_t offset, const Variant &v) {
-        char *mem = data + offset;
-
-        switch (v.type()) {
-        case DataType::Bool:
-            bool b;
-            v.get(b);
-            std::memcpy(mem, &b, sizeof(b));
-            break;
-
-        case DataType::Double:
-            double d;
-            v.get(d);
-            std::memcpy(mem, &d, sizeof(d));
-            break;
-
-        case DataType::UInt32:
-            uint32_t ui32;
-            v.get(ui32);
-            std::memcpy(mem, &ui32, sizeof(ui32));
-            break;
-
-        case DataType::Int32:
-            int32_t i32;
-            v.get(i32);
-            std::memcpy(mem, &i32, sizeof(i32));
-            break;
-
-        case DataType::UInt64:
-            uint64_t ui64;
-            v.get(ui64);
-            std::memcpy(mem, &ui64, sizeof(ui64));
-            break;
-
-        case DataType::Int64:
-            int64_t i64;
-            v.get(i64);
-            std::memcpy(mem, &i64, sizeof(i64));
-            break;
-
-        case DataType::String:
-            const char *str;
-            str = v.get<const char *>();
-            std::memcpy(mem, &str, sizeof(str));
-            break;
-
-        default:
-            throw std::invalid_argument("Unhandled DataType");
-        };
+        copy_value(data + offset, v);
     }
 
     void copyData(Variant &v, size_t offset, DataType data_type) {
-        char *mem = data + offset;
-
-        switch (data_type) {
-        case DataType::Bool:
-            bool b;
-            std::memcpy(&b, mem, sizeof(b));
-            v.set(b);
-            break;
-
-        case DataType::Double:
-            double d;
-            std::memcpy(&d, mem, sizeof(d));
-            v.set(d);
-            break;
-
-        case DataType::UInt32:
-            uint32_t ui32;
-            std::memcpy(&ui32, mem, sizeof(ui32));
-            v.set(ui32);
-            break;
-
-        case DataType::Int32:
-            int32_t i32;
-            std::memcpy(&i32, mem, sizeof(i32));
-            v.set(i32);
-            break;
-
-        case DataType::UInt64:
-            uint64_t ui64;
-            std::memcpy(&ui64, mem, sizeof(ui64));
-            v.set(ui64);
-            break;
-
-        case DataType::Int64:
-            int64_t i64;
-            std::memcpy(&i64, mem, sizeof(i64));
-            v.set(i64);
-            break;
-
-        case DataType::String:
-            const char *str;
-            std::memcpy(&str, mem, sizeof(str));
-            v.set(str);
-            break;
-
-        default:
-            throw std::invalid_argument("Unhandled DataType");
-        };
+        copy_data(v, data + offset, data_type);
     }
 
     void copyData(Variant &v, unsigned i) {
@@ -347,15 +555,73 @@ struct Janus {
 };
 
 
+static void write_cell(DataSet &ds, ndsize_t row, const Variant &v) {
+    h5x::DataType mt = data_type_to_h5_memtype(v.type());
+    std::vector<char> mem(mt.size());
+    copy_value(mem.data(), v);
+    ds.write(mem.data(), mt, NDSize{1}, NDSize{row});
+}
+
+static Variant read_cell(const DataSet &ds, ndsize_t row) {
+    const DataType dtype = data_type_from_h5(ds.dataType());
+    h5x::DataType mt = data_type_to_h5_memtype(dtype);
+    std::vector<char> mem(mt.size());
+
+    DataSpace fileSpace, memSpace;
+    std::tie(memSpace, fileSpace) = ds.offsetCount2DataSpaces(NDSize{1}, NDSize{row});
+    ds.read(mem.data(), mt, memSpace, fileSpace);
+
+    Variant v;
+    copy_data(v, mem.data(), dtype);
+    ds.vlenReclaim(mt, mem.data(), &memSpace);
+    return v;
+}
+
 void DataFrameHDF5::writeCells(ndsize_t row, const std::vector<Cell> &cells) {
+    checkRows(row, 1);
+    if (columnar()) {
+        const std::vector<std::string> all = columnNames();
+        std::vector<std::string> names;
+        for (const Cell &c : cells) {
+            names.push_back(c.haveName() ? c.name : column_name(all, static_cast<unsigned>(c.col)));
+        }
+
+        std::vector<IndexKeys> old = indexKeys(names, row, 1);
+        for (size_t i = 0; i < cells.size(); i++) {
+            DataSet ds = columnData(names[i]);
+            write_cell(ds, row, cells[i]);
+        }
+        updateIndexes(old, row);
+        return;
+    }
+
     DataSet ds = data();
     h5x::DataType dt = ds.dataType();
     Janus j{dt, cells};
 
+    std::vector<IndexKeys> old = indexKeys(j.dtype.member_names(), row, 1);
     ds.write(j.data, j.dtype, NDSize{1}, NDSize{row});
+    updateIndexes(old, row);
 }
 
 void DataFrameHDF5::writeRow(ndsize_t row, const std::vector<Variant> &vals) {
+    checkRows(row, 1);
+    if (columnar()) {
+        const std::vector<std::string> all = columnNames();
+        std::vector<std::string> names;
+        for (size_t i = 0; i < vals.size(); i++) {
+            names.push_back(column_name(all, static_cast<unsigned>(i)));
+        }
+
+        std::vector<IndexKeys> old = indexKeys(names, row, 1);
+        for (size_t i = 0; i < vals.size(); i++) {
+            DataSet ds = columnData(static_cast<unsigned>(i));
+            write_cell(ds, row, vals[i]);
+        }
+        updateIndexes(old, row);
+        return;
+    }
+
     DataSet ds = data();
     h5x::DataType dt = ds.dataType();
     std::vector<Cell> cells;
@@ -369,10 +635,127 @@ void DataFrameHDF5::writeRow(ndsize_t row, const std::vector<Variant> &vals) {
 
     Janus j{dt, cells};
 
+    std::vector<IndexKeys> old = indexKeys(j.dtype.member_names(), row, 1);
     ds.write(j.data, j.dtype, NDSize{1}, NDSize{row});
+    updateIndexes(old, row);
+}
+
+static bool same_types(const std::vector<Variant> &a, const std::vector<Variant> &b) {
+    return a.size() == b.size() &&
+           std::equal(a.cbegin(), a.cend(), b.cbegin(),
+                      [](const Variant &x, const Variant &y) {
+                          return x.type() == y.type();
+                      });
+}
+
+static void write_rows(DataSet &ds, ndsize_t offset, const std::vector<std::vector<Variant>> &rows) {
+    h5x::DataType dt = ds.dataType();
+
+    // one compound buffer and one write for every run of rows with the same value types
+    size_t start = 0;
+    while (start < rows.size()) {
+        size_t end = start + 1;
+        while (end < rows.size() && same_types(rows[start], rows[end])) {
+            end++;
+        }
+
+        Janus j{dt, rows, start, end - start};
+        ds.write(j.data, j.dtype, NDSize{end - start}, NDSize{offset + start});
+        start = end;
+    }
+}
+
+// the values of one column, one write for every run of values with the same type
+static void write_column_rows(DataSet &ds, ndsize_t offset, const std::vector<std::vector<Variant>> &rows, size_t col) {
+    size_t start = 0;
+    while (start < rows.size()) {
+        if (rows[start].size() <= col) {
+            start++;
+            continue;
+        }
+
+        const DataType dtype = rows[start][col].type();
+        size_t end = start + 1;
+        while (end < rows.size() && rows[end].size() > col && rows[end][col].type() == dtype) {
+            end++;
+        }
+
+        h5x::DataType mt = data_type_to_h5_memtype(dtype);
+        const size_t es = mt.size();
+        std::vector<char> mem(es * (end - start));
+        for (size_t r = start; r < end; r++) {
+            copy_value(mem.data() + (r - start) * es, rows[r][col]);
+        }
+
+        ds.write(mem.data(), mt, NDSize{end - start}, NDSize{offset + start});
+        start = end;
+    }
+}
+
+void DataFrameHDF5::writeRows(ndsize_t offset, const std::vector<std::vector<Variant>> &rows) {
+    checkRows(offset, rows.size());
+
+    // only the columns the rows have values for are written
+    std::vector<std::string> names = columnNames();
+    size_t width = 0;
+    for (const std::vector<Variant> &row : rows) {
+        width = std::max(width, row.size());
+    }
+    names.resize(std::min(width, names.size()));
+
+    std::vector<IndexKeys> old = indexKeys(names, offset, rows.size());
+    if (columnar()) {
+        for (size_t i = 0; i < names.size(); i++) {
+            DataSet ds = columnData(static_cast<unsigned>(i));
+            write_column_rows(ds, offset, rows, i);
+        }
+    } else {
+        DataSet ds = data();
+        write_rows(ds, offset, rows);
+    }
+    updateIndexes(old, offset);
+}
+
+ndsize_t DataFrameHDF5::appendRows(const std::vector<std::vector<Variant>> &rows) {
+    if (columnar()) {
+        const ndsize_t offset = this->rows();
+        if (rows.empty()) {
+            return offset;
+        }
+
+        const std::vector<std::string> names = columnNames();
+        for (size_t i = 0; i < names.size(); i++) {
+            DataSet ds = columnData(static_cast<unsigned>(i));
+            resize(ds, offset + rows.size(), true);
+            write_column_rows(ds, offset, rows, i);
+        }
+        appendToIndexes(offset, rows.size());
+        return offset;
+    }
+
+    DataSet ds = data();
+    const ndsize_t offset = logical_rows(std::dynamic_pointer_cast<FileHDF5>(file()), ds);
+    if (rows.empty()) {
+        return offset;
+    }
+
+    resize(ds, offset + rows.size(), true);
+    write_rows(ds, offset, rows);
+    appendToIndexes(offset, rows.size());
+    return offset;
 }
 
 std::vector<Cell> DataFrameHDF5::readCells(ndsize_t row, const std::vector<std::string> &cols) const {
+    checkRows(row, 1);
+    if (columnar()) {
+        std::vector<Cell> res(cols.size());
+        for (size_t i = 0; i < cols.size(); i++) {
+            res[i] = Cell{cols[i], read_cell(columnData(cols[i]), row)};
+            res[i].col = static_cast<int>(i);
+        }
+        return res;
+    }
+
     DataSet ds = data();
     h5x::DataType dtype = ds.dataType();
 
@@ -391,6 +774,16 @@ std::vector<Cell> DataFrameHDF5::readCells(ndsize_t row, const std::vector<std::
 }
 
 std::vector<Variant> DataFrameHDF5::readRow(ndsize_t row) const {
+    checkRows(row, 1);
+    if (columnar()) {
+        const std::vector<std::string> names = columnNames();
+        std::vector<Variant> res(names.size());
+        for (size_t i = 0; i < names.size(); i++) {
+            res[i] = read_cell(columnData(static_cast<unsigned>(i)), row);
+        }
+        return res;
+    }
+
     DataSet ds = data();
     h5x::DataType dts = ds.dataType();
 
@@ -423,25 +816,32 @@ void DataFrameHDF5::writeColumn(const std::string &name,
                                 ndsize_t count,
                                 DataType dtype,
                                 const void *data) {
-    DataSet ds = this->data();
-    h5x::DataType dts = ds.dataType();
+    checkRows(offset, count);
+    const bool columnar = this->columnar();
+    DataSet ds = columnar ? columnData(name) : this->data();
     h5x::DataType memType = data_type_to_h5_memtype(dtype);
     size_t ms = memType.size();
 
-    h5x::DataType ct = h5x::DataType::makeCompound(ms);
-    ct.insert(name, 0, memType);
+    // the column of the compound data set, or the whole data set of the column
+    h5x::DataType ct = memType;
+    if (!columnar) {
+        ct = h5x::DataType::makeCompound(ms);
+        ct.insert(name, 0, memType);
+    }
 
     NDSize ndcount = {count};
     NDSize ndoffset = {offset};
     DataSpace fileSpace, memSpace;
     std::tie(memSpace, fileSpace) = ds.offsetCount2DataSpaces(ndcount, ndoffset);
 
+    std::vector<IndexKeys> old = indexKeys({name}, offset, count);
     if (dtype == DataType::String) {
         StringReader reader(ndcount, data);
         ds.write(*reader, ct, memSpace, fileSpace);
     } else {
         ds.write(data, ct, memSpace, fileSpace);
     }
+    updateIndexes(old, offset);
 }
 
 void DataFrameHDF5::readColumn(const std::string &name,
@@ -449,13 +849,17 @@ void DataFrameHDF5::readColumn(const std::string &name,
                                ndsize_t count,
                                DataType dtype,
                                void *data) const {
-    DataSet ds = this->data();
-    h5x::DataType dts = ds.dataType();
+    checkRows(offset, count);
+    const bool columnar = this->columnar();
+    DataSet ds = columnar ? columnData(name) : this->data();
     h5x::DataType memType = data_type_to_h5_memtype(dtype);
 
     size_t ms = memType.size();
-    h5x::DataType ct = h5x::DataType::makeCompound(ms);
-    ct.insert(name, 0, memType);
+    h5x::DataType ct = memType;
+    if (!columnar) {
+        ct = h5x::DataType::makeCompound(ms);
+        ct.insert(name, 0, memType);
+    }
 
     NDSize ndcount = {count};
     NDSize ndoffset = {offset};
@@ -472,5 +876,588 @@ void DataFrameHDF5::readColumn(const std::string &name,
     }
 }
 
+void DataFrameHDF5::readColumns(const std::vector<std::string> &names,
+                                ndsize_t offset,
+                                ndsize_t count,
+                                const std::vector<DataType> &dtypes,
+                                const std::vector<void *> &data) const {
+    if (dtypes.size() != names.size() || data.size() != names.size()) {
+        throw std::invalid_argument("DataFrame: need one type and one buffer per column");
+    }
+    for (size_t i = 1; i < names.size(); i++) {
+        if (std::find(names.cbegin(), names.cbegin() + i, names[i]) != names.cbegin() + i) {
+            throw std::invalid_argument("DataFrame: column " + names[i] + " requested more than once");
+        }
+    }
+
+    const size_t n = nix::check::fits_in_size_t(count, "Cannot allocate storage (exceeds memory)");
+    if (names.empty() || n == 0) {
+        return;
+    }
+    checkRows(offset, count);
+
+    if (columnar()) {
+        // every column is a data set of its own, read only those
+        for (size_t i = 0; i < names.size(); i++) {
+            readColumn(names[i], offset, count, dtypes[i], data[i]);
+        }
+        return;
+    }
+
+    // one compound with only the requested members, all columns come from a single read
+    std::vector<size_t> offsets(names.size());
+    size_t ms = 0;
+    for (size_t i = 0; i < names.size(); i++) {
+        offsets[i] = ms;
+        ms += data_type_to_h5_memtype(dtypes[i]).size();
+    }
+
+    h5x::DataType ct = h5x::DataType::makeCompound(ms);
+    for (size_t i = 0; i < names.size(); i++) {
+        ct.insert(names[i], offsets[i], data_type_to_h5_memtype(dtypes[i]));
+    }
+
+    DataSet ds = this->data();
+    NDSize ndcount = {count};
+    NDSize ndoffset = {offset};
+    DataSpace fileSpace, memSpace;
+    std::tie(memSpace, fileSpace) = ds.offsetCount2DataSpaces(ndcount, ndoffset);
+
+    std::vector<char> rows(ms * n);
+    ds.read(rows.data(), ct, memSpace, fileSpace);
+
+    for (size_t i = 0; i < names.size(); i++) {
+        const char *src = rows.data() + offsets[i];
+
+        if (dtypes[i] == DataType::String) {
+            std::string *out = static_cast<std::string *>(data[i]);
+            for (size_t r = 0; r < n; r++) {
+                const char *str;
+                std::memcpy(&str, src + r * ms, sizeof(str));
+                out[r] = str ? str : "";
+            }
+        } else {
+            char *out = static_cast<char *>(data[i]);
+            const size_t es = data_type_to_size(dtypes[i]);
+            for (size_t r = 0; r < n; r++) {
+                std::memcpy(out + r * es, src + r * ms, es);
+            }
+        }
+    }
+
+    ds.vlenReclaim(ct.h5id(), rows.data(), &memSpace);
+}
+
+// the type of the keys in the index of a column of the given type
+static DataType index_key_type(DataType column) {
+    switch (column) {
+    case DataType::Float:
+    case DataType::Double:
+        return DataType::Double;
+    case DataType::Int8:
+    case DataType::Int16:
+    case DataType::Int32:
+    case DataType::Int64:
+        return DataType::Int64;
+    case DataType::UInt8:
+    case DataType::UInt16:
+    case DataType::UInt32:
+    case DataType::UInt64:
+        return DataType::UInt64;
+    case DataType::String:
+        return DataType::String;
+    default:
+        throw std::invalid_argument("DataFrame: columns of this type can not be indexed");
+    }
+}
+
+// rows overwritten at once whose index entries are moved one by one,
+// the indexes of larger writes are marked outdated until createIndex rebuilds them
+static const ndsize_t max_index_updates = 16;
+
+template<typename T>
+struct IndexEntry {
+    T key;
+    uint64_t row;
+};
+
+template<typename T>
+static bool key_less(const T &a, const T &b) {
+    return a < b;
+}
+
+// NaN are sorted after all numbers
+static bool key_less(double a, double b) {
+    return !std::isnan(a) && (std::isnan(b) || a < b);
+}
+
+// entries with equal keys are sorted by row
+template<typename T>
+static bool entry_less(const IndexEntry<T> &a, const IndexEntry<T> &b) {
+    if (key_less(a.key, b.key)) {
+        return true;
+    }
+    return !key_less(b.key, a.key) && a.row < b.row;
+}
+
+// the compound of the (key, row) entries of an index
+static h5x::DataType index_type(DataType key_type, bool for_memory) {
+    h5x::DataType key = data_type_to_h5(key_type, for_memory);
+    h5x::DataType row = data_type_to_h5(DataType::UInt64, for_memory);
+    h5x::DataType ct = h5x::DataType::makeCompound(key.size() + row.size());
+    ct.insert("key", 0, key);
+    ct.insert("row", key.size(), row);
+    return ct;
+}
+
+template<typename T>
+static void store_key(char *dst, const T &key) {
+    std::memcpy(dst, &key, sizeof(key));
+}
+
+static void store_key(char *dst, const std::string &key) {
+    const char *str = key.c_str();
+    std::memcpy(dst, &str, sizeof(str));
+}
+
+template<typename T>
+static void load_key(const char *src, T &key) {
+    std::memcpy(&key, src, sizeof(key));
+}
+
+static void load_key(const char *src, std::string &key) {
+    const char *str;
+    std::memcpy(&str, src, sizeof(str));
+    key = str ? str : "";
+}
+
+template<typename T>
+static std::vector<IndexEntry<T>> read_entries(const DataSet &index, ndsize_t offset, ndsize_t count) {
+    const DataType key_type = to_data_type<T>::value;
+    std::vector<IndexEntry<T>> entries(nix::check::fits_in_size_t(count, "Cannot allocate storage (exceeds memory)"));
+    if (count == 0) {
+        return entries;
+    }
+
+    h5x::DataType mt = index_type(key_type, true);
+    const size_t es = mt.size();
+    const size_t key_size = es - sizeof(uint64_t);
+    std::vector<char> buffer(entries.size() * es);
+
+    DataSpace fileSpace, memSpace;
+    std::tie(memSpace, fileSpace) = index.offsetCount2DataSpaces(NDSize{count}, NDSize{offset});
+    index.read(buffer.data(), mt, memSpace, fileSpace);
+
+    for (size_t i = 0; i < entries.size(); i++) {
+        load_key(buffer.data() + i * es, entries[i].key);
+        std::memcpy(&entries[i].row, buffer.data() + i * es + key_size, sizeof(uint64_t));
+    }
+    if (key_type == DataType::String) {
+        index.vlenReclaim(mt, buffer.data(), &memSpace);
+    }
+    return entries;
+}
+
+// the keys of string entries point into the entries, they must outlive the write
+template<typename T>
+static void write_entries(DataSet &index, ndsize_t offset, const std::vector<IndexEntry<T>> &entries) {
+    if (entries.empty()) {
+        return;
+    }
+
+    h5x::DataType mt = index_type(to_data_type<T>::value, true);
+    const size_t es = mt.size();
+    const size_t key_size = es - sizeof(uint64_t);
+    std::vector<char> buffer(entries.size() * es);
+    for (size_t i = 0; i < entries.size(); i++) {
+        store_key(buffer.data() + i * es, entries[i].key);
+        std::memcpy(buffer.data() + i * es + key_size, &entries[i].row, sizeof(uint64_t));
+    }
+    index.write(buffer.data(), mt, NDSize{entries.size()}, NDSize{offset});
+}
+
+// the position of the first entry that is not less than entry, found by binary search
+template<typename T>
+static ndsize_t entry_position(const DataSet &index, const IndexEntry<T> &entry) {
+    ndsize_t begin = 0, end = index.size()[0];
+    while (begin < end) {
+        const ndsize_t mid = begin + (end - begin) / 2;
+        if (entry_less(read_entries<T>(index, mid, 1)[0], entry)) {
+            begin = mid + 1;
+        } else {
+            end = mid;
+        }
+    }
+    return begin;
+}
+
+template<typename T>
+static std::vector<T> read_keys(const DataFrameHDF5 &df, const std::string &name, ndsize_t offset, ndsize_t count) {
+    std::vector<T> keys(nix::check::fits_in_size_t(count, "Cannot allocate storage (exceeds memory)"));
+    if (count > 0) {
+        df.readColumn(name, offset, count, to_data_type<T>::value, keys.data());
+    }
+    return keys;
+}
+
+template<typename T>
+static void write_index(const DataFrameHDF5 &df, const std::string &name, ndsize_t n, DataSet &index) {
+    std::vector<T> keys = read_keys<T>(df, name, 0, n);
+    std::vector<IndexEntry<T>> entries(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+        entries[i] = IndexEntry<T>{std::move(keys[i]), i};
+    }
+    std::sort(entries.begin(), entries.end(), entry_less<T>);
+    write_entries(index, 0, entries);
+}
+
+// the rows appended to the frame have the highest row numbers, so the new
+// entries only need to be merged with the entries after the smallest of them,
+// which are none if the keys grow with the rows
+template<typename T>
+static bool merge_entries(const DataFrameHDF5 &df, const std::string &name, DataSet &index,
+                          ndsize_t offset, ndsize_t count) {
+    const ndsize_t n = index.size()[0];
+    if (n != offset) {
+        return false;
+    }
+
+    std::vector<T> keys = read_keys<T>(df, name, offset, count);
+    std::vector<IndexEntry<T>> added(keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+        added[i] = IndexEntry<T>{std::move(keys[i]), offset + i};
+    }
+    std::sort(added.begin(), added.end(), entry_less<T>);
+
+    const ndsize_t from = entry_position(index, added.front());
+    std::vector<IndexEntry<T>> tail = read_entries<T>(index, from, n - from);
+    std::vector<IndexEntry<T>> merged;
+    merged.reserve(tail.size() + added.size());
+    std::merge(tail.begin(), tail.end(), added.begin(), added.end(), std::back_inserter(merged), entry_less<T>);
+
+    index.setExtent({n + count});
+    write_entries(index, from, merged);
+    return true;
+}
+
+// every changed entry is removed from its old position and inserted at its new
+// one, shifting the entries in between by one
+template<typename T>
+static bool move_entries(const DataFrameHDF5 &df, const std::string &name, DataSet &index,
+                         ndsize_t offset, const std::vector<Variant> &old_keys) {
+    std::vector<T> keys = read_keys<T>(df, name, offset, old_keys.size());
+    const ndsize_t n = index.size()[0];
+
+    for (size_t i = 0; i < keys.size(); i++) {
+        const IndexEntry<T> old{old_keys[i].get<T>(), offset + i};
+        const IndexEntry<T> now{keys[i], offset + i};
+        if (!entry_less(old, now) && !entry_less(now, old)) {
+            continue;
+        }
+
+        const ndsize_t p = entry_position(index, old);
+        if (p >= n) {
+            return false;
+        }
+        const IndexEntry<T> found = read_entries<T>(index, p, 1)[0];
+        if (entry_less(found, old) || entry_less(old, found)) {
+            return false;
+        }
+
+        const ndsize_t q = entry_position(index, now);
+        std::vector<IndexEntry<T>> moved;
+        if (p < q) {
+            moved = read_entries<T>(index, p + 1, q - p - 1);
+            moved.push_back(now);
+            write_entries(index, p, moved);
+        } else {
+            moved.push_back(now);
+            std::vector<IndexEntry<T>> shifted = read_entries<T>(index, q, p - q);
+            moved.insert(moved.end(), shifted.begin(), shifted.end());
+            write_entries(index, q, moved);
+        }
+    }
+    return true;
+}
+
+std::string DataFrameHDF5::indexName(const std::string &name) const {
+    return std::to_string(column_index(columnNames(), name));
+}
+
+void DataFrameHDF5::buildIndex(const std::string &name) {
+    const DataType key_type = index_key_type(columnType(name));
+    const ndsize_t n = rows();
+    const std::string link = indexName(name);
+
+    H5Group indexes = group().openGroup("indexes", true);
+    DataSet index;
+    if (indexes.hasData(link)) {
+        index = indexes.openData(link);
+        index.setExtent({n});
+    } else {
+        index = indexes.createData(link, index_type(key_type, false), {n});
+    }
+
+    switch (key_type) {
+    case DataType::Double:
+        write_index<double>(*this, name, n, index);
+        break;
+    case DataType::Int64:
+        write_index<int64_t>(*this, name, n, index);
+        break;
+    case DataType::UInt64:
+        write_index<uint64_t>(*this, name, n, index);
+        break;
+    default:
+        write_index<std::string>(*this, name, n, index);
+        break;
+    }
+
+    index.setAttr("valid", true);
+}
+
+std::vector<DataFrameHDF5::IndexKeys> DataFrameHDF5::indexKeys(const std::vector<std::string> &names,
+                                                              ndsize_t offset, ndsize_t count) const {
+    std::vector<IndexKeys> old;
+    if (count == 0 || !group().hasGroup("indexes")) {
+        return old;
+    }
+
+    H5Group indexes = group().openGroup("indexes", false);
+    for (const std::string &name : names) {
+        const std::string link = indexName(name);
+        if (!indexes.hasData(link)) {
+            continue;
+        }
+
+        DataSet index = indexes.openData(link);
+        bool valid = false;
+        index.getAttr("valid", valid);
+        if (!valid) {
+            continue;
+        }
+        if (count > max_index_updates) {
+            index.setAttr("valid", false);
+            continue;
+        }
+
+        IndexKeys entry{name, index_key_type(columnType(name)), {}};
+        switch (entry.key_type) {
+        case DataType::Double:
+            for (double k : read_keys<double>(*this, name, offset, count)) entry.keys.emplace_back(k);
+            break;
+        case DataType::Int64:
+            for (int64_t k : read_keys<int64_t>(*this, name, offset, count)) entry.keys.emplace_back(k);
+            break;
+        case DataType::UInt64:
+            for (uint64_t k : read_keys<uint64_t>(*this, name, offset, count)) entry.keys.emplace_back(k);
+            break;
+        default:
+            for (const std::string &k : read_keys<std::string>(*this, name, offset, count)) entry.keys.emplace_back(k);
+            break;
+        }
+        old.push_back(std::move(entry));
+    }
+    return old;
+}
+
+void DataFrameHDF5::updateIndexes(const std::vector<IndexKeys> &old, ndsize_t offset) const {
+    if (old.empty()) {
+        return;
+    }
+
+    H5Group indexes = group().openGroup("indexes", false);
+    for (const IndexKeys &entry : old) {
+        DataSet index = indexes.openData(indexName(entry.name));
+        bool updated;
+        switch (entry.key_type) {
+        case DataType::Double:
+            updated = move_entries<double>(*this, entry.name, index, offset, entry.keys);
+            break;
+        case DataType::Int64:
+            updated = move_entries<int64_t>(*this, entry.name, index, offset, entry.keys);
+            break;
+        case DataType::UInt64:
+            updated = move_entries<uint64_t>(*this, entry.name, index, offset, entry.keys);
+            break;
+        default:
+            updated = move_entries<std::string>(*this, entry.name, index, offset, entry.keys);
+            break;
+        }
+        if (!updated) {
+            index.setAttr("valid", false);
+        }
+    }
+}
+
+void DataFrameHDF5::appendToIndexes(ndsize_t offset, ndsize_t count) const {
+    if (count == 0 || !group().hasGroup("indexes")) {
+        return;
+    }
+
+    const std::vector<std::string> names = columnNames();
+    H5Group indexes = group().openGroup("indexes", false);
+    for (ndsize_t i = 0; i < indexes.objectCount(); i++) {
+        const std::string link = indexes.objectName(i);
+        const std::string &name = column_name(names, static_cast<unsigned>(std::stoul(link)));
+        DataSet index = indexes.openData(link);
+        bool valid = false;
+        index.getAttr("valid", valid);
+        if (!valid) {
+            continue;
+        }
+
+        bool merged;
+        switch (index_key_type(columnType(name))) {
+        case DataType::Double:
+            merged = merge_entries<double>(*this, name, index, offset, count);
+            break;
+        case DataType::Int64:
+            merged = merge_entries<int64_t>(*this, name, index, offset, count);
+            break;
+        case DataType::UInt64:
+            merged = merge_entries<uint64_t>(*this, name, index, offset, count);
+            break;
+        default:
+            merged = merge_entries<std::string>(*this, name, index, offset, count);
+            break;
+        }
+        if (!merged) {
+            index.setAttr("valid", false);
+        }
+    }
+}
+
+void DataFrameHDF5::invalidateIndexes(const std::vector<std::string> &names) const {
+    if (!group().hasGroup("indexes")) {
+        return;
+    }
+
+    const std::vector<std::string> all = columnNames();
+    H5Group indexes = group().openGroup("indexes", false);
+    for (ndsize_t i = 0; i < indexes.objectCount(); i++) {
+        const std::string link = indexes.objectName(i);
+        const std::string &column = column_name(all, static_cast<unsigned>(std::stoul(link)));
+        if (!names.empty() && std::find(names.cbegin(), names.cend(), column) == names.cend()) {
+            continue;
+        }
+
+        DataSet index = indexes.openData(link);
+        bool valid = false;
+        index.getAttr("valid", valid);
+        if (valid) {
+            index.setAttr("valid", false);
+        }
+    }
+}
+
+void DataFrameHDF5::createIndex(const std::string &name) {
+    buildIndex(name);
+}
+
+bool DataFrameHDF5::hasIndex(const std::string &name) const {
+    if (!group().hasGroup("indexes")) {
+        return false;
+    }
+
+    const std::vector<std::string> names = columnNames();
+    auto it = std::find(names.cbegin(), names.cend(), name);
+    return it != names.cend() &&
+        group().openGroup("indexes", false).hasData(std::to_string(it - names.cbegin()));
+}
+
+bool DataFrameHDF5::deleteIndex(const std::string &name) {
+    if (!hasIndex(name)) {
+        return false;
+    }
+
+    group().openGroup("indexes", false).removeData(indexName(name));
+    return true;
+}
+
+// the entries [first, last) of the index with lower <= key <= upper, found by binary search
+template<typename T>
+static std::pair<ndsize_t, ndsize_t> index_range(const DataSet &index, const void *lower, const void *upper) {
+    const T &lo = *static_cast<const T *>(lower);
+    const T &hi = *static_cast<const T *>(upper);
+    if (!(lo <= hi)) {
+        // also if a bound is NaN, which no value is equal to
+        return std::make_pair(0, 0);
+    }
+
+    const ndsize_t n = index.size()[0];
+    ndsize_t begin = 0, end = n;
+    while (begin < end) {
+        const ndsize_t mid = begin + (end - begin) / 2;
+        if (key_less(read_entries<T>(index, mid, 1)[0].key, lo)) {
+            begin = mid + 1;
+        } else {
+            end = mid;
+        }
+    }
+    const ndsize_t first = begin;
+
+    end = n;
+    while (begin < end) {
+        const ndsize_t mid = begin + (end - begin) / 2;
+        if (key_less(hi, read_entries<T>(index, mid, 1)[0].key)) {
+            end = mid;
+        } else {
+            begin = mid + 1;
+        }
+    }
+
+    return std::make_pair(first, begin);
+}
+
+bool DataFrameHDF5::lookup(const std::string &name,
+                           DataType dtype,
+                           const void *lower,
+                           const void *upper,
+                           std::vector<ndsize_t> &rows) const {
+    if (!hasIndex(name)) {
+        return false;
+    }
+
+    H5Group indexes = group().openGroup("indexes", false);
+    DataSet index = indexes.openData(indexName(name));
+    bool valid = false;
+    index.getAttr("valid", valid);
+    if (!valid) {
+        // outdated by a large write, a lookup must not write so the column is scanned
+        return false;
+    }
+
+    std::pair<ndsize_t, ndsize_t> range;
+    switch (dtype) {
+    case DataType::Double:
+        range = index_range<double>(index, lower, upper);
+        break;
+    case DataType::Int64:
+        range = index_range<int64_t>(index, lower, upper);
+        break;
+    case DataType::UInt64:
+        range = index_range<uint64_t>(index, lower, upper);
+        break;
+    case DataType::String:
+        range = index_range<std::string>(index, lower, upper);
+        break;
+    default:
+        return false;
+    }
+
+    const ndsize_t count = range.second - range.first;
+    rows.resize(nix::check::fits_in_size_t(count, "Cannot allocate storage (exceeds memory)"));
+    if (count > 0) {
+        h5x::DataType row_mem = data_type_to_h5_memtype(DataType::UInt64);
+        h5x::DataType mt = h5x::DataType::makeCompound(row_mem.size());
+        mt.insert("row", 0, row_mem);
+        index.read(rows.data(), mt, NDSize{count}, NDSize{range.first});
+    }
+
+    std::sort(rows.begin(), rows.end());
+    return true;
+}
+
 }
 }
@@ -22,6 +22,8 @@ namespace hdf5 {
 class DataFrameHDF5 : virtual public base::IDataFrame, public EntityWithSourcesHDF5 {
 private:
 
+    // the layout is fixed once the data is created
+    bool columnar_layout;
 
 public:
 
@@ -41,7 +43,10 @@ public:
     DataFrameHDF5(const std::shared_ptr<base::IFile> &file, const std::shared_ptr<base::IBlock> &block, const H5Group &group, const std::string &id, const std::string &type, const std::string &name, time_t time);
 
 
-    void createData(const std::vector<Column> &cols, const Compression &compression);
+    void createData(const std::vector<Column> &cols, const Compression &compression,
+                    DataFrameLayout layout = DataFrameLayout::Rows);
+
+    DataFrameLayout layout() const override;
 
     std::vector<Column> columns() const override;
 
@@ -57,6 +62,9 @@ public:
     std::vector<Variant> readRow(ndsize_t row) const override;
     void writeRow(ndsize_t row, const std::vector<Variant> &v) override;
 
+    void writeRows(ndsize_t offset, const std::vector<std::vector<Variant>> &rows) override;
+    ndsize_t appendRows(const std::vector<std::vector<Variant>> &rows) override;
+
     std::vector<Cell> readCells(ndsize_t row, const std::vector<std::string> &names) const override;
     void writeCells(ndsize_t row, const std::vector<Cell> &cells) override;
 
@@ -67,12 +75,28 @@ public:
                     DataType dtype,
                     void *data) const override;
 
+    void readColumns(const std::vector<std::string> &names,
+                     ndsize_t offset,
+                     ndsize_t count,
+                     const std::vector<DataType> &dtypes,
+                     const std::vector<void *> &data) const override;
+
     void writeColumn(const std::string &name,
                      ndsize_t offset,
                      ndsize_t count,
                      DataType dtype,
                      const void *data) override;
 
+    void createIndex(const std::string &name) override;
+    bool hasIndex(const std::string &name) const override;
+    bool deleteIndex(const std::string &name) override;
+
+    bool lookup(const std::string &name,
+                DataType dtype,
+                const void *lower,
+                const void *upper,
+                std::vector<ndsize_t> &rows) const override;
+
 private:
     DataSet data() const {
         if (! group().hasData("data")) {
@@ -82,6 +106,48 @@ private:
         return group().openData("data");
     }
 
+    // the columnar layout stores one data set per column in the "columns" group
+    bool columnar() const {
+        return columnar_layout;
+    }
+
+    std::vector<std::string> columnNames() const;
+
+    DataSet columnData(unsigned col) const;
+    DataSet columnData(const std::string &name) const;
+
+    DataType columnType(const std::string &name) const;
+
+    void resize(DataSet &ds, ndsize_t n, bool over_allocate);
+
+    // the data sets may be larger than the frame, so HDF5 can not check the bounds
+    void checkRows(ndsize_t offset, ndsize_t count) const;
+
+    // indexes are named by column index, column names need not be valid link names
+    std::string indexName(const std::string &name) const;
+
+    void buildIndex(const std::string &name);
+
+    // the keys of rows that are about to be overwritten, in one index
+    struct IndexKeys {
+        std::string name;
+        DataType key_type;
+        std::vector<Variant> keys;
+    };
+
+    // read the keys of the rows [offset, offset + count) from the up to date
+    // indexes of the given columns, before the rows are overwritten
+    std::vector<IndexKeys> indexKeys(const std::vector<std::string> &names, ndsize_t offset, ndsize_t count) const;
+
+    // move the entries of the overwritten rows to their new keys
+    void updateIndexes(const std::vector<IndexKeys> &old, ndsize_t offset) const;
+
+    // merge the rows [offset, offset + count) into the up to date indexes
+    void appendToIndexes(ndsize_t offset, ndsize_t count) const;
+
+    // mark the indexes of the given columns, or of all columns, as outdated
+    void invalidateIndexes(const std::vector<std::string> &names = {}) const;
+
 };
 
 
@@ -7,6 +7,7 @@
 // LICENSE file in the root of the Project.
 
 #include "DimensionHDF5.hpp"
+#include "FileHDF5.hpp"
 #include <nix/util/util.hpp>
 
 using namespace std;
@@ -66,7 +67,7 @@ std::string dimensionTypeToStr(DimensionType dim) {
 }
 
 
-shared_ptr<IDimension> openDimensionHDF5(const H5Group &group, ndsize_t index) {
+shared_ptr<IDimension> openDimensionHDF5(const H5Group &group, ndsize_t index, const shared_ptr<IFile> &file) {
     string type_name;
     group.getAttr("dimension_type", type_name);
 
@@ -78,7 +79,7 @@ shared_ptr<IDimension> openDimensionHDF5(const H5Group &group, ndsize_t index) {
             dim = make_shared<SetDimensionHDF5>(group, index);
             break;
         case DimensionType::Range:
-            dim = make_shared<RangeDimensionHDF5>(group, index);
+            dim = make_shared<RangeDimensionHDF5>(group, index, file);
             break;
         case DimensionType::Sample:
             dim = make_shared<SampledDimensionHDF5>(group, index);
@@ -416,7 +417,13 @@ DataFrameDimensionHDF5::~DataFrameDimensionHDF5() {}
 //--------------------------------------------------------------
 
 RangeDimensionHDF5::RangeDimensionHDF5(const H5Group &group, ndsize_t index)
-    : DimensionHDF5(group, index)
+    : RangeDimensionHDF5(group, index, nullptr)
+{
+}
+
+
+RangeDimensionHDF5::RangeDimensionHDF5(const H5Group &group, ndsize_t index, const shared_ptr<IFile> &file)
+    : DimensionHDF5(group, index), entity_file(file), max_cached_ticks(default_max_cached_ticks)
 {
     setType();
 }
@@ -430,8 +437,9 @@ RangeDimensionHDF5::RangeDimensionHDF5(const H5Group &group, ndsize_t index, vec
 }
 
 
-RangeDimensionHDF5::RangeDimensionHDF5(const H5Group &group, ndsize_t index, const DataArrayHDF5 &array)
-    :RangeDimensionHDF5(group, index)
+RangeDimensionHDF5::RangeDimensionHDF5(const H5Group &group, ndsize_t index, const shared_ptr<IFile> &file,
+                                       const DataArrayHDF5 &array)
+    :RangeDimensionHDF5(group, index, file)
 {
     setType();
     this->group.createLink(array.group(), array.id());
@@ -516,46 +524,153 @@ bool RangeDimensionHDF5::alias() const {
 }
 
 
-vector<double> RangeDimensionHDF5::ticks() const {
-    vector<double> ticks;
+const ndsize_t RangeDimensionHDF5::default_max_cached_ticks = 1 << 24;
+
+
+ndsize_t RangeDimensionHDF5::maxCachedTicks() const {
+    return max_cached_ticks;
+}
+
+
+void RangeDimensionHDF5::maxCachedTicks(ndsize_t count) {
+    max_cached_ticks = count;
+    if (tick_cache && tick_cache->size() > count) {
+        tick_cache.reset();
+    }
+}
+
+
+static vector<double> read_ticks(const DataSet &ds, ndsize_t start, size_t count) {
+    vector<double> ticks(count);
+    h5x::DataType memType = data_type_to_h5_memtype(nix::DataType::Double);
+    DataSpace fileSpace, memSpace;
+    nix::NDSize offst(1, start);
+    nix::NDSize cnt(1, count);
+    std::tie(memSpace, fileSpace) = ds.offsetCount2DataSpaces(cnt, offst);
+    ds.read(ticks.data(),  memType, memSpace, fileSpace);
+    return ticks;
+}
+
+
+DataSet RangeDimensionHDF5::ticksData() const {
     H5Group g = redirectGroup();
     if (g.hasData("ticks")) {
-        g.getData("ticks", ticks);
-        return ticks;
+        return g.openData("ticks");
     } else if (g.hasData("data")) {
-        g.getData("data", ticks);
-        return ticks;
+        return g.openData("data");
     } else {
         throw MissingAttr("ticks");
     }
 }
 
 
+vector<double> RangeDimensionHDF5::ticks() const {
+    shared_ptr<const vector<double>> cached = cachedTicks();
+    return cached ? *cached : readTicks();
+}
+
+
+shared_ptr<const vector<double>> RangeDimensionHDF5::cachedTicks() const {
+    if (!tick_cache && tickCount() <= max_cached_ticks) {
+        tick_cache = make_shared<const vector<double>>(readTicks());
+    }
+    return tick_cache;
+}
+
+
+ndsize_t RangeDimensionHDF5::tickExtent(const DataSet &ds) const {
+    shared_ptr<FileHDF5> f = dynamic_pointer_cast<FileHDF5>(entity_file);
+    boost::optional<NDSize> logical = f ? f->logicalExtent(ds) : boost::none;
+    NDSize s = logical ? *logical : ds.size();
+    return s.size() > 0 ? s[0] : 0;
+}
+
+
+vector<double> RangeDimensionHDF5::readTicks() const {
+    DataSet ds = ticksData();
+    size_t n = nix::check::fits_in_size_t(tickExtent(ds), "Too many ticks to read them at once");
+    return n > 0 ? read_ticks(ds, 0, n) : vector<double>();
+}
+
+
+ndsize_t RangeDimensionHDF5::tickCount() const {
+    if (tick_cache) {
+        return tick_cache->size();
+    }
+    return tickExtent(ticksData());
+}
+
+
+ndsize_t RangeDimensionHDF5::lowerBound(double position) const {
+    shared_ptr<const vector<double>> cached = cachedTicks();
+    if (cached) {
+        return std::lower_bound(cached->begin(), cached->end(), position) - cached->begin();
+    }
+
+    // too many ticks to load them: binary search over blocks of one chunk,
+    // reading only the first tick of each visited block, then search the
+    // one block that contains the bound
+    DataSet ds = ticksData();
+    ndsize_t n = tickExtent(ds);
+    NDSize chunks = ds.chunking();
+    ndsize_t block = chunks ? chunks[0] : 8192;
+    ndsize_t nblocks = (n + block - 1) / block;
+
+    ndsize_t lo = 0, hi = nblocks;
+    while (lo < hi) {
+        ndsize_t mid = lo + (hi - lo) / 2;
+        ndsize_t offset = mid * block;
+
+        auto it = tick_samples.find(offset);
+        if (it == tick_samples.end()) {
+            it = tick_samples.emplace(offset, read_ticks(ds, offset, 1)[0]).first;
+        }
+
+        if (it->second < position) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    if (lo == 0) {
+        return 0;
+    }
+
+    ndsize_t start = (lo - 1) * block;
+    size_t count = static_cast<size_t>(std::min(block, n - start));
+    vector<double> values = read_ticks(ds, start, count);
+    return start + (std::lower_bound(values.begin(), values.end(), position) - values.begin());
+}
+
+
 vector<double> RangeDimensionHDF5::ticks(ndsize_t start, size_t count) const {
     vector<double> ticks;
     if (count > ticks.max_size()) {
         throw nix::OutOfBounds("count exceeds the maximum size of std::vector!");
     }
-    ticks.resize(count);
 
-    H5Group g = redirectGroup();
-    std::string dset_name = g.hasData("ticks") ? "ticks" : "data";
-    DataSet ds = g.openData(dset_name);
-    NDSize s = ds.size();
-    if (start > s[0] || count > s[0] || (start + count) > s[0]) {
+    if (tick_cache) {
+        if (start > tick_cache->size() || count > tick_cache->size() || (start + count) > tick_cache->size()) {
+            throw nix::OutOfBounds("Access to RangeDimensionHDF5::ticks: start is out of Bounds!");
+        }
+        auto first = tick_cache->begin() + static_cast<ptrdiff_t>(start);
+        ticks.assign(first, first + static_cast<ptrdiff_t>(count));
+        return ticks;
+    }
+
+    DataSet ds = ticksData();
+    ndsize_t n = tickExtent(ds);
+    if (start > n || count > n || (start + count) > n) {
         throw nix::OutOfBounds("Access to RangeDimensionHDF5::ticks: start is out of Bounds!");
     }
-    h5x::DataType memType = data_type_to_h5_memtype(nix::DataType::Double);
-    DataSpace fileSpace, memSpace;
-    nix::NDSize offst(1, start);
-    nix::NDSize cnt(1, count);
-    std::tie(memSpace, fileSpace) = ds.offsetCount2DataSpaces(cnt, offst);
-    ds.read(ticks.data(),  memType, memSpace, fileSpace);
-    return ticks;
+    return read_ticks(ds, start, count);
 }
 
 
 void RangeDimensionHDF5::ticks(const vector<double> &ticks) {
+    tick_cache.reset();
+    tick_samples.clear();
     H5Group g = redirectGroup();
     if (!alias()) {
         g.setData("ticks", ticks);
@@ -563,6 +678,10 @@ void RangeDimensionHDF5::ticks(const vector<double> &ticks) {
         NDSize extent(1, ticks.size());
         DataSet ds = g.openData("data");
         ds.setExtent(extent);
+        shared_ptr<FileHDF5> f = dynamic_pointer_cast<FileHDF5>(entity_file);
+        if (f) {
+            f->logicalExtent(ds, NDSize());
+        }
         ds.write(ticks);
     } else {
         throw MissingAttr("ticks");
@@ -19,6 +19,7 @@
 #include "DataFrameHDF5.hpp"
 
 #include <string>
+#include <map>
 #include <iostream>
 #include <ctime>
 #include <memory>
@@ -33,7 +34,8 @@ DimensionType dimensionTypeFromStr(const std::string &str);
 std::string dimensionTypeToStr(DimensionType dim);
 
 
-std::shared_ptr<base::IDimension> openDimensionHDF5(const H5Group &group, ndsize_t index);
+std::shared_ptr<base::IDimension> openDimensionHDF5(const H5Group &group, ndsize_t index,
+                                                   const std::shared_ptr<base::IFile> &file = nullptr);
 
 
 class DimensionHDF5 : virtual public base::IDimension {
@@ -185,10 +187,14 @@ public:
     RangeDimensionHDF5(const H5Group &group, ndsize_t index);
 
 
+    RangeDimensionHDF5(const H5Group &group, ndsize_t index, const std::shared_ptr<base::IFile> &file);
+
+
     RangeDimensionHDF5(const H5Group &group, ndsize_t index, std::vector<double> ticks);
 
 
-    RangeDimensionHDF5(const H5Group &group, ndsize_t index, const DataArrayHDF5 &dataArray);
+    RangeDimensionHDF5(const H5Group &group, ndsize_t index, const std::shared_ptr<base::IFile> &file,
+                       const DataArrayHDF5 &dataArray);
 
 
     DimensionType dimensionType() const;
@@ -224,11 +230,50 @@ public:
     void ticks(const std::vector<double> &ticks);
 
 
+    std::shared_ptr<const std::vector<double>> cachedTicks() const;
+
+
+    ndsize_t tickCount() const;
+
+
+    ndsize_t lowerBound(double position) const;
+
+
+    /**
+     * @brief Dimensions with more ticks than this are not loaded into
+     *        memory but searched block-wise in the file.
+     */
+    ndsize_t maxCachedTicks() const;
+
+
+    void maxCachedTicks(ndsize_t count);
+
+
     virtual ~RangeDimensionHDF5();
 
+
+    static const ndsize_t default_max_cached_ticks;
+
 private:
 
+    // the file of an alias dimension knows the logical extent of over-allocated data
+    std::shared_ptr<base::IFile> entity_file;
+
+    ndsize_t max_cached_ticks;
+
+    // all ticks, filled on first use and dropped when the ticks are written
+    mutable std::shared_ptr<const std::vector<double>> tick_cache;
+    // first tick of the blocks visited by the on-disk search, by offset
+    mutable std::map<ndsize_t, double> tick_samples;
+
     H5Group redirectGroup() const;
+
+    DataSet ticksData() const;
+
+    // the number of ticks in ds, which may be over-allocated if it is the data of an alias dimension
+    ndsize_t tickExtent(const DataSet &ds) const;
+
+    std::vector<double> readTicks() const;
 };
 
 
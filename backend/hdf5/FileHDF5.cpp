@@ -14,6 +14,7 @@
 #include "h5x/H5Exception.hpp"
 
 
+#include <exception>
 #include <fstream>
 #include <vector>
 #include <ctime>
@@ -42,8 +43,9 @@ static unsigned int map_file_mode(FileMode mode) {
 }
 
 
-FileHDF5::FileHDF5(const string &name, FileMode mode, Compression compression, OpenFlags flags):
-    file_format_version(HDF5_FF_VERSION) {
+FileHDF5::FileHDF5(const string &name, FileMode mode, Compression compression, OpenFlags flags,
+                   const ChunkCache &cache):
+    cache(cache), open_flags(flags), file_format_version(HDF5_FF_VERSION) {
     if (!fileExists(name)) {
         mode = FileMode::Overwrite;
     }
@@ -59,10 +61,19 @@ FileHDF5::FileHDF5(const string &name, FileMode mode, Compression compression, O
 
     bool is_create = !fileExists(name) || h5mode == H5F_ACC_TRUNC;
 
+    // the default chunk cache of all data sets, Auto is handled when the data sets are opened
+    H5Object fapl = H5Pcreate(H5P_FILE_ACCESS);
+    fapl.check("Could not create file access plist");
+    if (cache.mode == ChunkCache::Mode::Fixed) {
+        ChunkCache sized = DataSet::sizeChunkCache(cache, {}, 0, {}, {});
+        res = H5Pset_cache(fapl.h5id(), 0, sized.slots, sized.bytes, sized.w0);
+        res.check("Unable to set chunk cache (H5Pset_cache failed.)");
+    }
+
     if (is_create) {
-        hid = H5Fcreate(name.c_str(), h5mode, fcpl.h5id(), H5P_DEFAULT);
+        hid = H5Fcreate(name.c_str(), h5mode, fcpl.h5id(), fapl.h5id());
     } else {
-        hid = H5Fopen(name.c_str(), h5mode, H5P_DEFAULT);
+        hid = H5Fopen(name.c_str(), h5mode, fapl.h5id());
     }
 
     if (!H5Iis_valid(hid)) {
@@ -85,6 +96,8 @@ FileHDF5::FileHDF5(const string &name, FileMode mode, Compression compression, O
 
 
 bool FileHDF5::flush() {
+    trimExtents();
+    writeIdIndex();
     HErr err = H5Fflush(hid, H5F_SCOPE_GLOBAL);
     return !err.isError();
 }
@@ -291,6 +304,24 @@ void FileHDF5::close() {
     if (!isOpen())
         return;
 
+    // the handles are released even if the data sets can not be trimmed
+    // or the index can not be written, the first error is rethrown
+    std::exception_ptr error;
+    try {
+        trimExtents();
+    } catch (...) {
+        // the entries hold open data sets
+        growing_extents.clear();
+        error = std::current_exception();
+    }
+    try {
+        writeIdIndex();
+    } catch (...) {
+        if (!error) {
+            error = std::current_exception();
+        }
+    }
+
     data.close();
     metadata.close();
     root.close();
@@ -322,6 +353,10 @@ void FileHDF5::close() {
     }
 
     H5Object::close();
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
 }
 
 
@@ -339,6 +374,11 @@ Compression FileHDF5::compression() const {
      return compr;
 }
 
+
+ChunkCache FileHDF5::chunkCache() const {
+    return cache;
+}
+
 shared_ptr<base::IFile> FileHDF5::file() const {
     return  const_pointer_cast<FileHDF5>(shared_from_this());
 }
@@ -410,6 +450,76 @@ void FileHDF5::createHeader() {
     }
 }
 
+void FileHDF5::writeIdIndex() {
+    if (mode == FileMode::ReadOnly || (open_flags & OpenFlags::IdIndex) != OpenFlags::IdIndex) {
+        return;
+    }
+
+    ndsize_t count = data.objectCount();
+    for (ndsize_t index = 0; index < count; index++) {
+        BlockHDF5::writeIdIndex(data.openGroup(data.objectName(index), false));
+    }
+}
+
+
+haddr_t FileHDF5::objectAddress(const H5Object &obj) {
+    H5O_info_t info;
+    HErr res = H5Oget_info(obj.h5id(), &info);
+    res.check("FileHDF5: Could not get object info");
+    return info.addr;
+}
+
+
+bool FileHDF5::growExtents() const {
+    return mode != FileMode::ReadOnly && (open_flags & OpenFlags::GrowExtents) == OpenFlags::GrowExtents;
+}
+
+
+boost::optional<NDSize> FileHDF5::logicalExtent(const DataSet &ds) const {
+    if (growing_extents.empty()) {
+        return boost::none;
+    }
+    return logicalExtent(objectAddress(ds));
+}
+
+
+boost::optional<NDSize> FileHDF5::logicalExtent(haddr_t addr) const {
+    auto it = growing_extents.find(addr);
+    if (it == growing_extents.end()) {
+        return boost::none;
+    }
+    return it->second.logical;
+}
+
+
+void FileHDF5::logicalExtent(const DataSet &ds, const NDSize &extent) {
+    if (!extent && growing_extents.empty()) {
+        return;
+    }
+    logicalExtent(objectAddress(ds), ds, extent);
+}
+
+
+void FileHDF5::logicalExtent(haddr_t addr, const DataSet &ds, const NDSize &extent) {
+    if (!extent) {
+        growing_extents.erase(addr);
+        return;
+    }
+    GrowingExtent &entry = growing_extents[addr];
+    entry.data = ds;
+    entry.logical = extent;
+}
+
+
+void FileHDF5::trimExtents() {
+    while (!growing_extents.empty()) {
+        auto it = growing_extents.begin();
+        it->second.data.setExtent(it->second.logical);
+        growing_extents.erase(it);
+    }
+}
+
+
 void FileHDF5::openRoot() {
     root = H5Group(H5Gopen2(hid, "/", H5P_DEFAULT));
     root.check("Could not open root group");
@@ -438,7 +548,11 @@ bool FileHDF5::operator!=(const FileHDF5 &other) const {
 
 
 FileHDF5::~FileHDF5() {
-    close();
+    // errors can not be reported from here, call close() to see them
+    try {
+        close();
+    } catch (...) {
+    }
 }
 
 } // ns nix::hdf5
@@ -15,6 +15,7 @@
 #include "h5x/H5Group.hpp"
 
 #include <string>
+#include <map>
 #include <memory>
 
 #define HDF5_FF_VERSION nix::FormatVersion({1, 2, 0})
@@ -31,10 +32,19 @@ private:
 
     /* groups representing different sections of the file */
     Compression compr;
+    ChunkCache cache;
     H5Group root, metadata, data;
     FileMode mode;
+    OpenFlags open_flags;
     FormatVersion file_format_version;
 
+    struct GrowingExtent {
+        DataSet data;
+        NDSize logical;
+    };
+    // data sets that are larger than their logical extent, by object address
+    std::map<haddr_t, GrowingExtent> growing_extents;
+
 public:
 
     /**
@@ -43,8 +53,10 @@ public:
      * @param name    The name of the file to open.
      * @param prefix  The prefix used for IDs.
      * @param mode    File open mode ReadOnly, ReadWrite or Overwrite.
+     * @param cache   The chunk cache configuration used for all DataArrays.
      */
-    FileHDF5(const std::string &name, const FileMode mode = FileMode::ReadWrite, const Compression compression = Compression::Auto, OpenFlags flags = OpenFlags::None);
+    FileHDF5(const std::string &name, const FileMode mode = FileMode::ReadWrite, const Compression compression = Compression::None,
+             OpenFlags flags = OpenFlags::None, const ChunkCache &cache = ChunkCache());
 
     //--------------------------------------------------
     // Methods concerning blocks
@@ -140,6 +152,46 @@ public:
     Compression compression() const;
 
 
+    ChunkCache chunkCache() const;
+
+
+    /**
+     * @brief Whether data that grows along one axis is over-allocated,
+     *        see OpenFlags::GrowExtents.
+     */
+    bool growExtents() const;
+
+    /**
+     * @brief The logical extent of a data set that was over-allocated,
+     *        none if the extent of the data set is its logical extent.
+     */
+    boost::optional<NDSize> logicalExtent(const DataSet &ds) const;
+
+    /**
+     * @brief The logical extent of the data set at the given address,
+     *        for callers that keep the address of an open data set.
+     */
+    boost::optional<NDSize> logicalExtent(haddr_t addr) const;
+
+    /**
+     * @brief Remember the logical extent of an over-allocated data set,
+     *        or forget it if extent is empty. The data set is trimmed to
+     *        its logical extent on flush() and close().
+     */
+    void logicalExtent(const DataSet &ds, const NDSize &extent);
+
+    /**
+     * @brief Remember or forget the logical extent of the data set ds at
+     *        the given address.
+     */
+    void logicalExtent(haddr_t addr, const DataSet &ds, const NDSize &extent);
+
+    /**
+     * @brief The address the logical extents of data sets are kept by.
+     */
+    static haddr_t objectAddress(const H5Object &obj);
+
+
     bool operator==(const FileHDF5 &other) const;
 
 
@@ -163,6 +215,12 @@ private:
 
 
     void createHeader();
+
+
+    void writeIdIndex();
+
+
+    void trimExtents();
 };
 
 
@@ -72,5 +72,10 @@ void DataSpace::hyperslab(const NDSize &count, const NDSize &start, H5S_seloper_
     status.check("DataSpace::hyperslab(): H5Sselect_hyperslab() failed!");
 }
 
+void DataSpace::hyperslab(const NDSize &count, const NDSize &start, const NDSize &stride, H5S_seloper_t op) {
+    HErr status = H5Sselect_hyperslab(hid, op, start.data(), stride.data(), count.data(), nullptr);
+    status.check("DataSpace::hyperslab(): H5Sselect_hyperslab() failed!");
+}
+
 } //::nix::hdf5
 } //::nix
@@ -33,6 +33,8 @@ public:
 
     void hyperslab(const NDSize &count, const NDSize &start, H5S_seloper_t op = H5S_SELECT_SET);
 
+    void hyperslab(const NDSize &count, const NDSize &start, const NDSize &stride, H5S_seloper_t op = H5S_SELECT_SET);
+
     DataSpace &operator=(const DataSpace &other) {
         H5Object::operator=(other);
         return *this;
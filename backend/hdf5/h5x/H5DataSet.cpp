@@ -11,6 +11,18 @@
 
 #include <iostream>
 #include <cmath>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <limits>
+#include <thread>
+#include <vector>
+
+#if defined(NIX_HAVE_ZLIB) && H5_VERSION_GE(1, 10, 3)
+#define NIX_PARALLEL_CHUNKS 1
+#include <zlib.h>
+#endif
 
 namespace nix {
 namespace hdf5 {
@@ -45,6 +57,299 @@ void DataSet::read(void *data, h5x::DataType memType, const NDSize &count, const
 }
 
 
+#ifdef NIX_PARALLEL_CHUNKS
+
+namespace {
+
+struct ChunkFilter {
+    H5Z_filter_t id;
+    int level; // compression level of deflate
+};
+
+
+// The filters of a data set in pipeline order, if all of them can be applied and undone by us
+bool chunk_filters(hid_t dcpl, std::vector<ChunkFilter> &filters) {
+    int nfilters = H5Pget_nfilters(dcpl);
+    if (nfilters < 0) {
+        return false;
+    }
+    for (unsigned i = 0; i < static_cast<unsigned>(nfilters); ++i) {
+        unsigned flags, config;
+        unsigned cd_values[8];
+        size_t cd_nelmts = 8;
+        H5Z_filter_t filter = H5Pget_filter2(dcpl, i, &flags, &cd_nelmts, cd_values, 0, nullptr, &config);
+        if (filter != H5Z_FILTER_DEFLATE && filter != H5Z_FILTER_SHUFFLE) {
+            return false;
+        }
+        int level = (filter == H5Z_FILTER_DEFLATE && cd_nelmts > 0) ? static_cast<int>(cd_values[0]) : 0;
+        filters.push_back(ChunkFilter{filter, level});
+    }
+    return true;
+}
+
+
+// Move on to the next chunk in [first, last], last dimension fastest; false when done
+bool next_chunk(NDSize &grid, const NDSize &first, const NDSize &last) {
+    size_t d = grid.size();
+    while (d > 0) {
+        --d;
+        if (++grid[d] <= last[d]) {
+            return true;
+        }
+        grid[d] = first[d];
+    }
+    return false;
+}
+
+
+// Undo the filters that were applied to a raw chunk, the result has chunk_bytes bytes
+void decode_chunk(const std::vector<ChunkFilter> &filters, uint32_t mask, size_t esize,
+                  std::vector<char> &raw, std::vector<char> &chunk, size_t chunk_bytes) {
+    for (size_t k = filters.size(); k-- > 0;) {
+        if (mask & (1u << k)) {
+            continue; // filter was skipped for this chunk
+        }
+        chunk.resize(chunk_bytes);
+        if (filters[k].id == H5Z_FILTER_DEFLATE) {
+            uLongf size = static_cast<uLongf>(chunk_bytes);
+            int res = uncompress(reinterpret_cast<Bytef *>(chunk.data()), &size,
+                                 reinterpret_cast<const Bytef *>(raw.data()), static_cast<uLong>(raw.size()));
+            if (res != Z_OK || size != chunk_bytes) {
+                throw H5Exception("DataSet::readParallel(): could not inflate chunk");
+            }
+        } else {
+            size_t nelms = raw.size() / esize;
+            for (size_t b = 0; b < esize; ++b) {
+                for (size_t i = 0; i < nelms; ++i) {
+                    chunk[i * esize + b] = raw[b * nelms + i];
+                }
+            }
+        }
+        raw.swap(chunk);
+    }
+    if (raw.size() != chunk_bytes) {
+        throw H5Exception("DataSet::readParallel(): unexpected chunk size");
+    }
+}
+
+
+// Apply the filters to a chunk of data, the result ends up in chunk
+void encode_chunk(const std::vector<ChunkFilter> &filters, size_t esize,
+                  std::vector<char> &chunk, std::vector<char> &scratch) {
+    for (const ChunkFilter &filter : filters) {
+        if (filter.id == H5Z_FILTER_DEFLATE) {
+            uLongf size = compressBound(static_cast<uLong>(chunk.size()));
+            scratch.resize(size);
+            int res = compress2(reinterpret_cast<Bytef *>(scratch.data()), &size,
+                                reinterpret_cast<const Bytef *>(chunk.data()), static_cast<uLong>(chunk.size()),
+                                filter.level);
+            if (res != Z_OK) {
+                throw H5Exception("DataSet::writeParallel(): could not deflate chunk");
+            }
+            scratch.resize(size);
+        } else {
+            scratch.resize(chunk.size());
+            size_t nelms = chunk.size() / esize;
+            for (size_t b = 0; b < esize; ++b) {
+                for (size_t i = 0; i < nelms; ++i) {
+                    scratch[b * nelms + i] = chunk[i * esize + b];
+                }
+            }
+        }
+        chunk.swap(scratch);
+    }
+}
+
+
+// Copy the part of a chunk that lies within the box [offset, offset + count) into data
+void scatter_chunk(const char *chunk, const NDSize &origin, const NDSize &chunks,
+                   char *data, const NDSize &offset, const NDSize &count, size_t esize) {
+    const size_t rank = chunks.size();
+    NDSize lo(rank), hi(rank);
+    for (size_t d = 0; d < rank; ++d) {
+        lo[d] = std::max(origin[d], offset[d]);
+        hi[d] = std::min(origin[d] + chunks[d], offset[d] + count[d]);
+    }
+
+    const size_t row_bytes = static_cast<size_t>(hi[rank - 1] - lo[rank - 1]) * esize;
+    NDSize idx = lo;
+    while (true) {
+        ndsize_t src = 0, dst = 0;
+        for (size_t d = 0; d < rank; ++d) {
+            src = src * chunks[d] + (idx[d] - origin[d]);
+            dst = dst * count[d] + (idx[d] - offset[d]);
+        }
+        std::memcpy(data + dst * esize, chunk + src * esize, row_bytes);
+
+        // next row, i.e. increment all but the last dimension
+        size_t d = rank - 1;
+        while (d > 0) {
+            --d;
+            if (++idx[d] < hi[d]) {
+                break;
+            }
+            idx[d] = lo[d];
+            if (d == 0) {
+                return;
+            }
+        }
+        if (rank == 1) {
+            return;
+        }
+    }
+}
+
+
+// Copy a chunk that lies completely within the box [offset, offset + count) out of data
+void gather_chunk(const char *data, const NDSize &offset, const NDSize &count,
+                  char *chunk, const NDSize &origin, const NDSize &chunks, size_t esize) {
+    const size_t rank = chunks.size();
+    const size_t row_bytes = static_cast<size_t>(chunks[rank - 1]) * esize;
+    const size_t nrows = static_cast<size_t>(chunks.nelms() / chunks[rank - 1]);
+    NDSize idx(rank, 0);
+    for (size_t row = 0; row < nrows; ++row) {
+        ndsize_t src = 0;
+        for (size_t d = 0; d < rank; ++d) {
+            src = src * count[d] + (origin[d] + idx[d] - offset[d]);
+        }
+        std::memcpy(chunk + row * row_bytes, data + src * esize, row_bytes);
+
+        for (size_t d = rank - 1; d-- > 0;) {
+            if (++idx[d] < chunks[d]) {
+                break;
+            }
+            idx[d] = 0;
+        }
+    }
+}
+
+} // anonymous namespace
+
+#endif
+
+
+void DataSet::readParallel(void *data, h5x::DataType memType, const NDSize &count, const NDSize &offset, size_t threads) const
+{
+#ifdef NIX_PARALLEL_CHUNKS
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    NDSize chunks = chunking();
+    const size_t rank = chunks.size();
+    h5x::DataType fileType = dataType();
+    std::vector<ChunkFilter> filters;
+    H5Object dcpl = H5Dget_create_plist(hid);
+    dcpl.check("DataSet::readParallel(): Could not get creation plist");
+
+    bool usable = threads > 1 && rank > 0 && count.size() == rank &&
+                  (!offset || offset.size() == rank) && count.nelms() > 0 &&
+                  H5Tequal(fileType.h5id(), memType.h5id()) > 0 &&
+                  H5Tis_variable_str(fileType.h5id()) == 0 &&
+                  chunk_filters(dcpl.h5id(), filters);
+
+    NDSize start = offset ? offset : NDSize(rank, 0);
+    NDSize first(rank), last(rank);
+    ndsize_t nchunks = 1;
+    if (usable) {
+        for (size_t d = 0; d < rank; ++d) {
+            first[d] = start[d] / chunks[d];
+            last[d] = (start[d] + count[d] - 1) / chunks[d];
+            nchunks *= last[d] - first[d] + 1;
+        }
+    }
+    if (!usable || nchunks < 2) {
+        read(data, memType, count, offset);
+        return;
+    }
+
+    const size_t esize = fileType.size();
+    const size_t chunk_bytes = static_cast<size_t>(chunks.nelms()) * esize;
+    char *dest = static_cast<char *>(data);
+
+    struct Chunk {
+        NDSize origin;
+        std::vector<char> raw;
+        uint32_t mask;
+    };
+
+    // chunks are read raw in batches on this thread and decoded by the workers
+    const size_t batch_size = threads * 4;
+    std::vector<Chunk> batch;
+    std::vector<NDSize> unallocated;
+    NDSize grid = first;
+    bool done = false;
+    while (!done) {
+        batch.clear();
+        while (!done && batch.size() < batch_size) {
+            Chunk c;
+            c.origin = NDSize(rank);
+            for (size_t d = 0; d < rank; ++d) {
+                c.origin[d] = grid[d] * chunks[d];
+            }
+
+            hsize_t stored = 0;
+            if (H5Dget_chunk_storage_size(hid, c.origin.data(), &stored) < 0 || stored == 0) {
+                unallocated.push_back(c.origin);
+            } else {
+                c.raw.resize(static_cast<size_t>(stored));
+                HErr res = H5Dread_chunk(hid, H5P_DEFAULT, c.origin.data(), &c.mask, c.raw.data());
+                res.check("DataSet::readParallel(): H5Dread_chunk failed");
+                batch.push_back(std::move(c));
+            }
+
+            done = !next_chunk(grid, first, last);
+        }
+
+        std::atomic<size_t> next(0);
+        std::vector<std::exception_ptr> errors(threads);
+        auto work = [&](size_t t) {
+            try {
+                std::vector<char> scratch;
+                for (size_t k = next++; k < batch.size(); k = next++) {
+                    decode_chunk(filters, batch[k].mask, esize, batch[k].raw, scratch, chunk_bytes);
+                    scatter_chunk(batch[k].raw.data(), batch[k].origin, chunks, dest, start, count, esize);
+                    std::vector<char>().swap(batch[k].raw);
+                }
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        };
+
+        size_t nworkers = std::min(threads, batch.size());
+        std::vector<std::thread> workers;
+        for (size_t t = 1; t < nworkers; ++t) {
+            workers.emplace_back(work, t);
+        }
+        work(0);
+        for (std::thread &worker : workers) {
+            worker.join();
+        }
+        for (const std::exception_ptr &error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+    }
+
+    // chunks that were never written: let HDF5 provide the fill value
+    for (const NDSize &origin : unallocated) {
+        NDSize lo(rank), n(rank);
+        for (size_t d = 0; d < rank; ++d) {
+            lo[d] = std::max(origin[d], start[d]);
+            n[d] = std::min(origin[d] + chunks[d], start[d] + count[d]) - lo[d];
+        }
+        std::vector<char> part(static_cast<size_t>(n.nelms()) * esize);
+        read(part.data(), memType, n, lo);
+        NDSize part_origin = lo;
+        scatter_chunk(part.data(), part_origin, n, dest, start, count, esize);
+    }
+#else
+    read(data, memType, count, offset);
+#endif
+}
+
+
 void DataSet::write(const void *data, h5x::DataType memType, const NDSize &count, const NDSize &offset)
 {
     DataSpace fileSpace, memSpace;
@@ -52,6 +357,162 @@ void DataSet::write(const void *data, h5x::DataType memType, const NDSize &count
     write(data, memType, memSpace, fileSpace);
 }
 
+
+void DataSet::writeParallel(const void *data, h5x::DataType memType, const NDSize &count, const NDSize &offset, size_t threads)
+{
+    // boxes that do not fit are refused before HDF5 fails on them
+    NDSize extent = size();
+    if (count.size() == extent.size() && (!offset || offset.size() == extent.size())) {
+        for (size_t d = 0; d < extent.size(); ++d) {
+            if ((offset ? offset[d] : 0) + count[d] > extent[d]) {
+                throw OutOfBounds("DataSet::writeParallel(): box exceeds the extent of the data set");
+            }
+        }
+    }
+
+#ifdef NIX_PARALLEL_CHUNKS
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    NDSize chunks = chunking();
+    const size_t rank = chunks.size();
+    h5x::DataType fileType = dataType();
+    std::vector<ChunkFilter> filters;
+    H5Object dcpl = H5Dget_create_plist(hid);
+    dcpl.check("DataSet::writeParallel(): Could not get creation plist");
+
+    bool usable = threads > 1 && rank > 0 && count.size() == rank &&
+                  (!offset || offset.size() == rank) && count.nelms() > 0 &&
+                  H5Tequal(fileType.h5id(), memType.h5id()) > 0 &&
+                  H5Tis_variable_str(fileType.h5id()) == 0 &&
+                  chunk_filters(dcpl.h5id(), filters);
+
+    // only chunks that are completely covered by the box can be written directly
+    NDSize start = offset ? offset : NDSize(rank, 0);
+    NDSize first(rank), last(rank);
+    if (usable) {
+        for (size_t d = 0; d < rank && usable; ++d) {
+            first[d] = (start[d] + chunks[d] - 1) / chunks[d];
+            usable = (start[d] + count[d]) / chunks[d] > first[d];
+            if (usable) {
+                last[d] = (start[d] + count[d]) / chunks[d] - 1;
+            }
+        }
+    }
+    if (!usable) {
+        write(data, memType, count, offset);
+        return;
+    }
+
+    const size_t esize = fileType.size();
+    const size_t chunk_bytes = static_cast<size_t>(chunks.nelms()) * esize;
+    const char *src = static_cast<const char *>(data);
+
+    // the parts of the box outside of the full chunks, one slab per dimension
+    NDSize inner_lo(rank), inner_hi(rank);
+    for (size_t d = 0; d < rank; ++d) {
+        inner_lo[d] = first[d] * chunks[d];
+        inner_hi[d] = (last[d] + 1) * chunks[d];
+    }
+    NDSize lo = start, hi = start + count;
+    for (size_t d = 0; d < rank; ++d) {
+        for (int side = 0; side < 2; ++side) {
+            NDSize part_lo = lo, part_hi = hi;
+            if (side == 0) {
+                part_hi[d] = inner_lo[d];
+            } else {
+                part_lo[d] = inner_hi[d];
+            }
+            if (part_hi[d] <= part_lo[d]) {
+                continue;
+            }
+            NDSize n = part_hi - part_lo;
+            std::vector<char> part(static_cast<size_t>(n.nelms()) * esize);
+            NDSize idx(rank, 0);
+            const size_t row_bytes = static_cast<size_t>(n[rank - 1]) * esize;
+            for (size_t row = 0; row < part.size() / row_bytes; ++row) {
+                ndsize_t pos = 0;
+                for (size_t k = 0; k < rank; ++k) {
+                    pos = pos * count[k] + (part_lo[k] + idx[k] - start[k]);
+                }
+                std::memcpy(part.data() + row * row_bytes, src + pos * esize, row_bytes);
+                for (size_t k = rank - 1; k-- > 0;) {
+                    if (++idx[k] < n[k]) {
+                        break;
+                    }
+                    idx[k] = 0;
+                }
+            }
+            write(part.data(), memType, n, part_lo);
+        }
+        // the remaining dimensions only need to cover the inner part of this one
+        lo[d] = inner_lo[d];
+        hi[d] = inner_hi[d];
+    }
+
+    struct Chunk {
+        NDSize origin;
+        std::vector<char> data;
+    };
+
+    // chunks are compressed in batches by the workers and written on this thread
+    const size_t batch_size = threads * 4;
+    std::vector<Chunk> batch;
+    NDSize grid = first;
+    bool done = false;
+    while (!done) {
+        batch.clear();
+        while (!done && batch.size() < batch_size) {
+            Chunk c;
+            c.origin = NDSize(rank);
+            for (size_t d = 0; d < rank; ++d) {
+                c.origin[d] = grid[d] * chunks[d];
+            }
+            batch.push_back(std::move(c));
+            done = !next_chunk(grid, first, last);
+        }
+
+        std::atomic<size_t> next(0);
+        std::vector<std::exception_ptr> errors(threads);
+        auto work = [&](size_t t) {
+            try {
+                std::vector<char> scratch;
+                for (size_t k = next++; k < batch.size(); k = next++) {
+                    batch[k].data.resize(chunk_bytes);
+                    gather_chunk(src, start, count, batch[k].data.data(), batch[k].origin, chunks, esize);
+                    encode_chunk(filters, esize, batch[k].data, scratch);
+                }
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        };
+
+        size_t nworkers = std::min(threads, batch.size());
+        std::vector<std::thread> workers;
+        for (size_t t = 1; t < nworkers; ++t) {
+            workers.emplace_back(work, t);
+        }
+        work(0);
+        for (std::thread &worker : workers) {
+            worker.join();
+        }
+        for (const std::exception_ptr &error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+
+        for (const Chunk &c : batch) {
+            HErr res = H5Dwrite_chunk(hid, H5P_DEFAULT, 0, c.origin.data(), c.data.size(), c.data.data());
+            res.check("DataSet::writeParallel(): H5Dwrite_chunk failed");
+        }
+    }
+#else
+    write(data, memType, count, offset);
+#endif
+}
+
 #define CHUNK_BASE   16*1024
 #define CHUNK_MIN     8*1024
 #define CHUNK_MAX  1024*1024
@@ -146,6 +607,123 @@ NDSize DataSet::guessChunking(NDSize chunks, size_t element_size)
     return chunks;
 }
 
+NDSize DataSet::chooseChunking(const NDSize &dims, size_t element_size, const AccessHint &hint)
+{
+    if (hint.empty()) {
+        return guessChunking(dims, element_size);
+    }
+
+    const size_t rank = dims.size();
+    if (rank == 0) {
+        throw InvalidRank("Cannot choose chunks for 0-dimensional data");
+    }
+    if (hint.append_axis && *hint.append_axis >= rank) {
+        throw OutOfBounds("AccessHint: append axis out of bounds", *hint.append_axis);
+    }
+    const bool has_box = hint.read_box.size() > 0;
+    if (has_box && hint.read_box.size() != rank) {
+        throw IncompatibleDimensions("AccessHint: read box must have the rank of the data", "chooseChunking");
+    }
+
+    size_t target;
+    switch (hint.workload) {
+        case AccessHint::Workload::ReadMostly:  target = 64 * 1024; break;
+        case AccessHint::Workload::WriteMostly: target = CHUNK_MAX; break;
+        default:                                target = 256 * 1024; break;
+    }
+    const ndsize_t target_elms = std::max<ndsize_t>(1, target / std::max<size_t>(1, element_size));
+
+    // dimensions that grow later are not limited by their current extent
+    const ndsize_t unlimited = std::numeric_limits<ndsize_t>::max() / 2;
+    NDSize bound(rank), chunks(rank);
+    for (size_t d = 0; d < rank; ++d) {
+        bool grows = (hint.append_axis && *hint.append_axis == d) || dims[d] == 0;
+        bound[d] = grows ? unlimited : dims[d];
+        if (has_box) {
+            chunks[d] = std::max<ndsize_t>(1, std::min(hint.read_box[d], bound[d]));
+        } else {
+            chunks[d] = grows ? 1 : dims[d];
+        }
+    }
+
+    // too large: halve the longest side
+    while (chunks.nelms() > target_elms) {
+        size_t d = static_cast<size_t>(std::max_element(chunks.begin(), chunks.end()) - chunks.begin());
+        chunks[d] = (chunks[d] + 1) / 2;
+    }
+
+    // too small: grow along the append axis, then along the longest side that can still grow
+    while (chunks.nelms() * 2 <= target_elms) {
+        size_t grow = rank;
+        if (hint.append_axis) {
+            grow = *hint.append_axis;
+        } else {
+            for (size_t d = 0; d < rank; ++d) {
+                if (chunks[d] < bound[d] && (grow == rank || chunks[d] > chunks[grow])) {
+                    grow = d;
+                }
+            }
+        }
+        if (grow == rank) {
+            break;
+        }
+        chunks[grow] = std::min(bound[grow], chunks[grow] * 2);
+    }
+
+    return chunks;
+}
+
+
+static size_t next_prime(size_t n) {
+    for (;; ++n) {
+        bool prime = n > 1;
+        for (size_t d = 2; d * d <= n && prime; ++d) {
+            prime = n % d != 0;
+        }
+        if (prime) {
+            return n;
+        }
+    }
+}
+
+
+ChunkCache DataSet::sizeChunkCache(const ChunkCache &cache, const NDSize &chunks, size_t element_size,
+                                   const NDSize &count, const NDSize &offset)
+{
+    if (cache.mode == ChunkCache::Mode::Default) {
+        return cache;
+    }
+
+    const size_t default_bytes = 1024 * 1024;
+    const size_t chunk_bytes = chunks ? static_cast<size_t>(chunks.nelms()) * element_size : 64 * 1024;
+    ChunkCache sized = ChunkCache::fixed(cache.bytes, cache.slots, cache.w0);
+
+    if (cache.mode == ChunkCache::Mode::Auto) {
+        // all chunks touched by the box, so that the next access can reuse them
+        ndsize_t nchunks = 1;
+        if (chunks && count.size() == chunks.size()) {
+            for (size_t d = 0; d < chunks.size(); ++d) {
+                ndsize_t start = offset.size() == chunks.size() ? offset[d] : 0;
+                if (count[d] == 0) {
+                    continue;
+                }
+                nchunks *= (start + count[d] - 1) / chunks[d] - start / chunks[d] + 1;
+            }
+        }
+        double wanted = static_cast<double>(nchunks) * static_cast<double>(chunk_bytes);
+        sized.bytes = static_cast<size_t>(std::min(wanted, static_cast<double>(cache.max_bytes)));
+        sized.bytes = std::max(sized.bytes, std::min(default_bytes, cache.max_bytes));
+        sized.slots = 0;
+    }
+
+    if (sized.slots == 0) {
+        size_t fit = std::max<size_t>(1, sized.bytes / std::max<size_t>(1, chunk_bytes));
+        sized.slots = next_prime(std::max<size_t>(521, std::min<size_t>(fit * 100, 1 << 20)));
+    }
+    return sized;
+}
+
+
 std::tuple<ndsize_t, ndsize_t> DataSet::getChunkBounds()
 {
     return std::make_tuple(CHUNK_MIN, CHUNK_MAX);
@@ -171,6 +749,26 @@ NDSize DataSet::size() const
     return getSpace().extent();
 }
 
+NDSize DataSet::chunking() const
+{
+    H5Object dcpl = H5Dget_create_plist(hid);
+    dcpl.check("DataSet::chunking(): Could not get creation plist");
+
+    if (H5Pget_layout(dcpl.h5id()) != H5D_CHUNKED) {
+        return NDSize{};
+    }
+
+    int rank = H5Pget_chunk(dcpl.h5id(), 0, nullptr);
+    if (rank < 0) {
+        throw H5Exception("DataSet::chunking(): Could not get chunk rank");
+    }
+
+    NDSize chunks(static_cast<size_t>(rank));
+    HErr res = H5Pget_chunk(dcpl.h5id(), rank, chunks.data());
+    res.check("DataSet::chunking(): Could not get chunk dimensions");
+    return chunks;
+}
+
 void DataSet::vlenReclaim(h5x::DataType mem_type, void *data, DataSpace *dspace) const
 {
     HErr res;
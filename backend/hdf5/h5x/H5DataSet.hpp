@@ -12,6 +12,8 @@
 #include "DataSpace.hpp"
 #include "H5DataType.hpp"
 #include "LocID.hpp"
+#include <nix/AccessHint.hpp>
+#include <nix/ChunkCache.hpp>
 #include <nix/Hydra.hpp>
 #include <nix/Value.hpp>
 
@@ -40,6 +42,23 @@ public:
     void read(void *data, h5x::DataType memType, const NDSize &count, const NDSize &offset=NDSize{}) const;
     void write(const void *data, h5x::DataType memType, const NDSize &count, const NDSize &offset=NDSize{});
 
+    /**
+     * @brief Same as read(), but the chunks of a deflate compressed data set
+     *        are read raw and decompressed on the given number of threads
+     *        (0 means one per core). Falls back to read() if the filters or
+     *        the memory type do not allow that.
+     */
+    void readParallel(void *data, h5x::DataType memType, const NDSize &count, const NDSize &offset, size_t threads) const;
+
+    /**
+     * @brief Same as write(), but the chunks that are completely covered by
+     *        count and offset are compressed on the given number of threads
+     *        (0 means one per core) and written with a direct chunk write.
+     *        The rest of the data is written with write(). Falls back to
+     *        write() if the filters or the memory type do not allow that.
+     */
+    void writeParallel(const void *data, h5x::DataType memType, const NDSize &count, const NDSize &offset, size_t threads);
+
     template<typename T> void read(T &value, bool resize = false) const;
     template<typename T> void write(const T &value);
 
@@ -47,6 +66,29 @@ public:
 
     static NDSize guessChunking(NDSize dims, size_t element_size);
 
+    /**
+     * @brief Choose the chunk shape for the given access pattern, falls
+     *        back to guessChunking() for an empty hint.
+     *
+     * Dimensions that are neither the append axis nor limited by the read
+     * box span the whole data. Chunks are grown along the append axis, and
+     * then along the longest side of the read box, until they reach a size
+     * that depends on the workload: 64 KiB for read-mostly, 256 KiB for
+     * balanced and 1 MiB for write-mostly access.
+     */
+    static NDSize chooseChunking(const NDSize &dims, size_t element_size, const AccessHint &hint);
+
+    /**
+     * @brief Resolve a chunk cache configuration to the number of bytes and
+     *        slots to use for a data set with the given chunk shape (empty if
+     *        unknown, then 64 KiB chunks are assumed) and the given box to
+     *        read or write (empty if unknown).
+     *
+     * @return The configuration in Mode::Fixed or Mode::Default.
+     */
+    static ChunkCache sizeChunkCache(const ChunkCache &cache, const NDSize &chunks, size_t element_size,
+                                     const NDSize &count, const NDSize &offset);
+
     /**
      * @brief returns the minimum and maximum chunk sizes
      *
@@ -56,6 +98,12 @@ public:
     void setExtent(const NDSize &dims);
     NDSize size() const;
 
+    /**
+     * @brief returns the chunk dimensions of the data set or an
+     *        empty NDSize if the data set is not chunked
+     */
+    NDSize chunking() const;
+
     void vlenReclaim(h5x::DataType mem_type, void *data, DataSpace *dspace = nullptr) const;
 
     h5x::DataType dataType(void) const;
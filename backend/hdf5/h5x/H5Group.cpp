@@ -14,6 +14,62 @@
 namespace nix {
 namespace hdf5 {
 
+namespace {
+
+// Compression for Compression::Auto: numeric data is shuffled and compressed with a fast
+// deflate level, data that is smaller than a few chunks or stored on the heap is left alone
+Compression auto_compression(const h5x::DataType &fileType, const NDSize &size, const NDSize &chunks) {
+    const H5T_class_t klass = fileType.class_t();
+    const bool numeric = klass == H5T_INTEGER || klass == H5T_FLOAT;
+    if (!chunks || (klass != H5T_COMPOUND && !numeric)) {
+        return Compression::None;
+    }
+    // extendible data sets are often created empty and filled later
+    if (size.nelms() > 0 && size.nelms() * fileType.size() < 4096) {
+        return Compression::None;
+    }
+    Compression c = Compression::deflate(1);
+    c.shuffle(numeric && fileType.size() > 1);
+    return c;
+}
+
+
+void set_filters(hid_t dcpl, const Compression &compression, const h5x::DataType &fileType) {
+    HErr res;
+    if (compression.scaleOffset() >= 0 && fileType.class_t() == H5T_INTEGER) {
+        res = H5Pset_scaleoffset(dcpl, H5Z_SO_INT, compression.scaleOffset());
+        res.check("Could not set scale-offset filter!");
+    }
+    if (compression.shuffle()) {
+        res = H5Pset_shuffle(dcpl);
+        res.check("Could not set shuffle filter!");
+    }
+
+    bool deflate = compression.codec() == Compression::Codec::Deflate;
+    if (compression.codec() == Compression::Codec::Filter) {
+        if (H5Zfilter_avail(static_cast<H5Z_filter_t>(compression.filterId())) > 0) {
+            const std::vector<unsigned> &params = compression.filterParams();
+            res = H5Pset_filter(dcpl, static_cast<H5Z_filter_t>(compression.filterId()), H5Z_FLAG_MANDATORY,
+                                params.size(), params.data());
+            res.check("Could not set compression filter!");
+        } else {
+            deflate = true;
+        }
+    }
+    if (deflate) {
+        res = H5Pset_deflate(dcpl, compression.level());
+        res.check("Could not set compression!");
+    }
+
+    if (compression.fletcher32()) {
+        res = H5Pset_fletcher32(dcpl);
+        res.check("Could not set fletcher32 filter!");
+    }
+}
+
+} // anonymous namespace
+
+
 optGroup::optGroup(const H5Group &parent, const std::string &g_name)
     : parent(parent), g_name(g_name)
 {}
@@ -77,7 +133,8 @@ boost::optional<H5Group> H5Group::findGroupByAttribute(const std::string &attrib
     boost::optional<H5Group> ret;
 
     // look up first direct sub-group that has given attribute with given value
-    for (ndsize_t index = 0; index < objectCount(); index++) {
+    ndsize_t count = objectCount();
+    for (ndsize_t index = 0; index < count; index++) {
         std::string obj_name = objectName(index);
         if(hasGroup(obj_name)) {
             H5Group group = openGroup(obj_name, false);
@@ -101,7 +158,8 @@ boost::optional<DataSet> H5Group::findDataByAttribute(const std::string &attribu
     boost::optional<DataSet> ret;
 
     // look up all direct sub-datasets that have the given attribute
-    for (ndsize_t index = 0; index < objectCount(); index++) {
+    ndsize_t count = objectCount();
+    for (ndsize_t index = 0; index < count; index++) {
         std::string obj_name = objectName(index);
         if(hasData(obj_name)) {
             DataSet ds = openData(obj_name);
@@ -218,21 +276,13 @@ DataSet H5Group::createData(const std::string &name,
         HErr res = H5Pset_chunk(dcpl.h5id(), rank, chunks.data());
         res.check("Could not set chunk size on data set creation plist");
     }
-    DataSet ds;
-    switch (compression) {
-        case Compression::None :
-            break;
-        case Compression::Auto :
-            break;
-        case Compression::DeflateNormal : {
-            HErr status = H5Pset_deflate (dcpl.h5id(), 6);
-            status.check("Could not set compression!");
-            break;
-        }
-        default : {
-            throw std::invalid_argument("Invalid compression flag!");
-        }
+    const Compression &filters = compression.codec() == Compression::Codec::Auto ?
+                                 auto_compression(fileType, size, chunks) : compression;
+    if (filters.enabled()) {
+        set_filters(dcpl.h5id(), filters, fileType);
     }
+
+    DataSet ds;
     ds = H5Dcreate(hid,
                    name.c_str(),
                    fileType.h5id(),
@@ -247,7 +297,12 @@ DataSet H5Group::createData(const std::string &name,
 
 
 DataSet H5Group::openData(const std::string &name) const {
-    DataSet ds = H5Dopen(hid, name.c_str(), H5P_DEFAULT);
+    return openData(name, H5P_DEFAULT);
+}
+
+
+DataSet H5Group::openData(const std::string &name, hid_t dapl) const {
+    DataSet ds = H5Dopen(hid, name.c_str(), dapl);
     ds.check("H5Group::openData(): Could not open DataSet");
     return ds;
 }
@@ -48,15 +48,16 @@ public:
     bool hasData(const std::string &name) const;
 
     DataSet createData(const std::string &name, const h5x::DataType &fileType,
-                       const NDSize &size,  const Compression &compression = Compression::Auto,
+                       const NDSize &size,  const Compression &compression = Compression::None,
                        const NDSize &maxsize = {}, NDSize chunks = {},
                        bool maxSizeUnlimited = true, bool guessChunks = true) const;
 
     DataSet openData(const std::string &name) const;
+    DataSet openData(const std::string &name, hid_t dapl) const;
     void removeData(const std::string &name);
 
     template<typename T>
-    void setData(const std::string &name, const T &value, const Compression &compression = Compression::Auto);
+    void setData(const std::string &name, const T &value, const Compression &compression = Compression::None);
     template<typename T>
     bool getData(const std::string &name, T &value) const;
 
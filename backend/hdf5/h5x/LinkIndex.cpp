@@ -0,0 +1,194 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "LinkIndex.hpp"
+#include "H5Exception.hpp"
+
+#include <exception>
+
+namespace nix {
+namespace hdf5 {
+
+namespace {
+
+struct ScanState {
+    const std::string &attribute;
+    std::unordered_map<std::string, std::string> &links;
+    // an exception must not unwind through H5Literate, it is rethrown after it returned
+    std::exception_ptr error;
+};
+
+herr_t scan_link(hid_t group, const char *name, const H5L_info_t *info, void *op_data) {
+    ScanState *state = static_cast<ScanState *>(op_data);
+
+    if (info->type != H5L_TYPE_HARD) {
+        return 0;
+    }
+
+    hid_t obj = H5Oopen(group, name, H5P_DEFAULT);
+    if (obj < 0) {
+        return 0;
+    }
+
+    if (H5Iget_type(obj) != H5I_GROUP) {
+        H5Oclose(obj);
+        return 0;
+    }
+
+    try {
+        H5Group child(obj);
+        std::string value;
+        if (child.getAttr(state->attribute, value)) {
+            // keep the first link, like H5Group::findGroupByAttribute does
+            state->links.emplace(value, std::string(name));
+        }
+    } catch (...) {
+        state->error = std::current_exception();
+        return -1;
+    }
+
+    return 0;
+}
+
+} // anonymous namespace
+
+
+LinkIndex::LinkIndex(const std::string &attribute)
+    : attribute(attribute), built(false)
+{}
+
+
+LinkIndex::Stamp LinkIndex::stamp(const H5Group &parent) {
+    H5G_info_t info;
+    HErr res = H5Gget_info(parent.h5id(), &info);
+    res.check("LinkIndex::stamp(): H5Gget_info failed");
+
+    Stamp s;
+    s.nlinks = info.nlinks;
+    s.max_corder = info.max_corder;
+    return s;
+}
+
+
+void LinkIndex::build(const H5Group &parent) {
+    links.clear();
+    state = stamp(parent);
+
+    ScanState scan{attribute, links, nullptr};
+    hsize_t idx = 0;
+    HErr res = H5Literate(parent.h5id(), H5_INDEX_CRT_ORDER, H5_ITER_INC, &idx, scan_link, &scan);
+    if (scan.error) {
+        links.clear();
+        std::rethrow_exception(scan.error);
+    }
+    if (res.isError()) {
+        // no creation order tracked for this group, fall back to name order
+        links.clear();
+        idx = 0;
+        res = H5Literate(parent.h5id(), H5_INDEX_NAME, H5_ITER_NATIVE, &idx, scan_link, &scan);
+        if (scan.error) {
+            links.clear();
+            std::rethrow_exception(scan.error);
+        }
+        res.check("LinkIndex::build(): H5Literate failed");
+    }
+
+    built = true;
+}
+
+
+boost::optional<H5Group> LinkIndex::openVerified(const H5Group &parent, const std::string &value) const {
+    auto it = links.find(value);
+    if (it == links.end() || !parent.hasGroup(it->second)) {
+        return boost::optional<H5Group>();
+    }
+
+    H5Group group = parent.openGroup(it->second, false);
+    std::string attr_value;
+    if (!group.getAttr(attribute, attr_value) || attr_value != value) {
+        return boost::optional<H5Group>();
+    }
+
+    return boost::make_optional(group);
+}
+
+
+boost::optional<H5Group> LinkIndex::findGroup(const H5Group &parent, const std::string &value) {
+    if (!built || stamp(parent) != state) {
+        build(parent);
+        return openVerified(parent, value);
+    }
+
+    boost::optional<H5Group> g = openVerified(parent, value);
+    if (!g && links.count(value) > 0) {
+        // stale entry, e.g. a link that was moved: rescan once
+        build(parent);
+        g = openVerified(parent, value);
+    }
+
+    return g;
+}
+
+
+void LinkIndex::insert(const H5Group &parent, const std::string &value, const std::string &link_name) {
+    if (!built) {
+        return;
+    }
+
+    // only take the shortcut if exactly one link was added since the last
+    // time we looked, otherwise somebody else modified the group as well
+    Stamp now = stamp(parent);
+    bool one_added = now.nlinks == state.nlinks + 1 &&
+                     (state.max_corder == 0 || now.max_corder == state.max_corder + 1);
+
+    if (one_added) {
+        links.emplace(value, link_name);
+        state = now;
+    } else {
+        invalidate();
+    }
+}
+
+
+void LinkIndex::erase(const H5Group &parent, const std::string &value) {
+    if (!built) {
+        return;
+    }
+
+    Stamp now = stamp(parent);
+    if (now.nlinks + 1 == state.nlinks && now.max_corder == state.max_corder) {
+        links.erase(value);
+        state = now;
+    } else {
+        invalidate();
+    }
+}
+
+
+void LinkIndex::assign(const Stamp &at, std::unordered_map<std::string, std::string> entries) {
+    links = std::move(entries);
+    state = at;
+    built = true;
+}
+
+
+const std::unordered_map<std::string, std::string> &LinkIndex::entries(const H5Group &parent) {
+    if (!built || stamp(parent) != state) {
+        build(parent);
+    }
+    return links;
+}
+
+
+void LinkIndex::invalidate() {
+    links.clear();
+    built = false;
+}
+
+} // namespace hdf5
+} // namespace nix
@@ -0,0 +1,116 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_LINK_INDEX_H
+#define NIX_LINK_INDEX_H
+
+#include "H5Group.hpp"
+#include <nix/Platform.hpp>
+
+#include <boost/optional.hpp>
+
+#include <string>
+#include <unordered_map>
+
+namespace nix {
+namespace hdf5 {
+
+/**
+ * @brief In-memory index that maps the value of a string attribute
+ *        (e.g. "entity_id") of the direct sub-groups of a container
+ *        group to the name of the link pointing to that sub-group.
+ *
+ * The index is built lazily by a single scan over the container on the
+ * first lookup. Afterwards lookups cost one hash lookup plus opening the
+ * matching group. The number of links and the creation order counter of
+ * the container are remembered, so that modifications done through other
+ * handles are detected and trigger a rebuild.
+ */
+class NIXAPI LinkIndex {
+
+public:
+
+    /**
+     * @brief Snapshot of the number of links and the creation order
+     *        counter of a group, used to detect modifications.
+     */
+    struct Stamp {
+        hsize_t nlinks = 0;
+        int64_t max_corder = 0;
+
+        bool operator==(const Stamp &other) const {
+            return nlinks == other.nlinks && max_corder == other.max_corder;
+        }
+
+        bool operator!=(const Stamp &other) const {
+            return !(*this == other);
+        }
+    };
+
+    static Stamp stamp(const H5Group &parent);
+
+    explicit LinkIndex(const std::string &attribute = "entity_id");
+
+    /**
+     * @brief Look for the sub-group of parent that has the indexed
+     *        attribute set to the given value. Builds (or rebuilds)
+     *        the index if necessary.
+     *
+     * @param parent    The container group the index belongs to.
+     * @param value     The value of the attribute to look for.
+     *
+     * @return Optional containing the group or an empty optional if not found.
+     */
+    boost::optional<H5Group> findGroup(const H5Group &parent, const std::string &value);
+
+    /**
+     * @brief Record that a link with the given name has been created
+     *        in parent for an object with the given attribute value.
+     */
+    void insert(const H5Group &parent, const std::string &value, const std::string &link_name);
+
+    /**
+     * @brief Record that the object with the given attribute value has
+     *        been unlinked from parent.
+     */
+    void erase(const H5Group &parent, const std::string &value);
+
+    /**
+     * @brief Fill the index with entries that were persisted earlier,
+     *        together with the stamp the container had at that time.
+     *        If the container has changed since, the entries are
+     *        discarded and rebuilt by scanning on the next lookup.
+     */
+    void assign(const Stamp &at, std::unordered_map<std::string, std::string> entries);
+
+    /**
+     * @brief Bring the index up to date with parent and return all entries.
+     */
+    const std::unordered_map<std::string, std::string> &entries(const H5Group &parent);
+
+    /**
+     * @brief Drop the index, forcing a rescan on the next lookup.
+     */
+    void invalidate();
+
+private:
+
+    void build(const H5Group &parent);
+
+    boost::optional<H5Group> openVerified(const H5Group &parent, const std::string &value) const;
+
+    std::string attribute;
+    std::unordered_map<std::string, std::string> links;
+    Stamp state;
+    bool built;
+};
+
+} // namespace hdf5
+} // namespace nix
+
+#endif /* NIX_LINK_INDEX_H */
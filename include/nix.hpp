@@ -24,3 +24,6 @@
 #include <nix/Source.hpp>
 #include <nix/Value.hpp>
 #include <nix/Compression.hpp>
+#include <nix/AccessHint.hpp>
+#include <nix/ChunkCache.hpp>
+#include <nix/DataSpan.hpp>
@@ -0,0 +1,63 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_ACCESS_HINT_H
+#define NIX_ACCESS_HINT_H
+
+#include <nix/NDSize.hpp>
+#include <nix/Platform.hpp>
+
+#include <boost/optional.hpp>
+
+namespace nix {
+
+/**
+ * @brief Describes how the data of a DataArray is going to be accessed,
+ *        used to choose the chunk shape when the data is created.
+ *
+ * For a channels x time recording that is appended along time and read
+ * one channel at a time, the hint would be:
+ *
+ * @code
+ * AccessHint hint;
+ * hint.append_axis = 1;
+ * hint.read_box = {1, 30000};
+ * hint.workload = AccessHint::Workload::ReadMostly;
+ * @endcode
+ *
+ * An empty hint selects the default chunking.
+ */
+class NIXAPI AccessHint {
+public:
+
+    enum class Workload {
+        Balanced,
+        ReadMostly,
+        WriteMostly
+    };
+
+    /**
+     * @brief The dimension along which data is appended.
+     */
+    boost::optional<size_t> append_axis;
+
+    /**
+     * @brief The shape of a typical read.
+     */
+    NDSize read_box;
+
+    Workload workload = Workload::Balanced;
+
+    bool empty() const {
+        return !append_axis && read_box.size() == 0 && workload == Workload::Balanced;
+    }
+};
+
+} // namespace nix
+
+#endif // NIX_ACCESS_HINT_H
@@ -351,7 +351,8 @@ public:
     * @param type         The type of the data array.
     * @param data_type    A nix::DataType indicating the format to store values.
     * @param shape        A NDSize holding the extent of the array to create.
-    * @param compression  En-/disable dataset compression, default nix::Compression::Auto.
+    * @param compression  The compression of the data, default nix::Compression::Auto, i.e. the compression of the file.
+    * @param hint         How the data is going to be accessed, used to choose the chunk shape.
     *
     * @return The newly created data array.
     */
@@ -359,7 +360,8 @@ public:
                               const std::string &type,
                               nix::DataType      data_type,
                               const NDSize      &shape,
-                              const Compression &compression=Compression::Auto);
+                              const Compression &compression=Compression::Auto,
+                              const AccessHint  &hint=AccessHint());
 
     /**
     * @brief Create a new data array associated with this block.
@@ -368,7 +370,7 @@ public:
     * @param type      The type of the data array.
     * @param data      Data to create array with.
     * @param data_type A optional nix::DataType indicating the format to store values.
-    * @param compression  En-/disable dataset compression, default nix::Compression::Auto.
+    * @param compression  The compression of the data, default nix::Compression::Auto, i.e. the compression of the file.
     *
     * Create a data array with shape and type inferred from data. After
     * successful creation, the contents of data will be written to the
@@ -439,14 +441,16 @@ public:
      * @param name         The name of the data frame to create.
      * @param type         The type of the data frame.
      * @param cols         A vector of nix::Column representing the columns to create.
-     * @param compression  En-/disable dataset compression, default nix::Compression::Auto.
+     * @param compression  The compression of the data, default nix::Compression::Auto, i.e. the compression of the file.
+     * @param layout       How the table is stored, see nix::DataFrameLayout.
      *
      * @return The newly created data frame.
      */
     DataFrame createDataFrame(const std::string &name,
                               const std::string &type,
                               const std::vector<Column> &cols,
-                              const Compression &compression=Compression::Auto) {
+                              const Compression &compression=Compression::Auto,
+                              DataFrameLayout layout=DataFrameLayout::Rows) {
         std::set<std::string> names;
         for (const Column &c : cols) {
             if (!Variant::supports_type(c.dtype)) {
@@ -458,7 +462,7 @@ public:
                 throw ConsistencyError("Block::createDataFrame: Column names must be unique!");
             }
         }
-        return backend()->createDataFrame(name, type, cols, compression);
+        return backend()->createDataFrame(name, type, cols, compression, layout);
     }
 
     /**
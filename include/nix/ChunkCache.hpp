@@ -0,0 +1,83 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_CHUNK_CACHE_H
+#define NIX_CHUNK_CACHE_H
+
+#include <nix/Platform.hpp>
+
+#include <cstddef>
+
+namespace nix {
+
+/**
+ * @brief Configuration of the cache that holds decompressed chunks of the
+ *        data of a DataArray.
+ *
+ * It can be given for a whole file when it is opened, see {@link File::open},
+ * or for a single DataArray, see {@link DataArray::chunkCache}. With
+ * Mode::Default the library defaults are used (1 MiB, 521 slots). With
+ * Mode::Fixed the given number of bytes and slots is used; if slots is 0 a
+ * suitable number is chosen. With Mode::Auto the cache is sized for every
+ * read and write such that all chunks touched by it fit, up to max_bytes.
+ */
+class NIXAPI ChunkCache {
+public:
+
+    enum class Mode {
+        Default,
+        Fixed,
+        Auto
+    };
+
+    Mode mode = Mode::Default;
+
+    /**
+     * @brief The size of the cache in bytes (Mode::Fixed).
+     */
+    size_t bytes = 0;
+
+    /**
+     * @brief The number of hash table slots, should be a prime number
+     *        about 100 times the number of chunks that fit into the cache.
+     *        0 to choose it from bytes and the chunk size.
+     */
+    size_t slots = 0;
+
+    /**
+     * @brief Preemption policy between 0 and 1, chunks that have been read
+     *        completely are evicted first the closer this is to 1.
+     */
+    double w0 = 0.75;
+
+    /**
+     * @brief The upper limit for the size of the cache (Mode::Auto).
+     */
+    size_t max_bytes = 256 * 1024 * 1024;
+
+    static ChunkCache fixed(size_t bytes, size_t slots = 0, double w0 = 0.75) {
+        ChunkCache c;
+        c.mode = Mode::Fixed;
+        c.bytes = bytes;
+        c.slots = slots;
+        c.w0 = w0;
+        return c;
+    }
+
+    static ChunkCache automatic(size_t max_bytes = 256 * 1024 * 1024, double w0 = 0.75) {
+        ChunkCache c;
+        c.mode = Mode::Auto;
+        c.max_bytes = max_bytes;
+        c.w0 = w0;
+        return c;
+    }
+};
+
+} // namespace nix
+
+#endif // NIX_CHUNK_CACHE_H
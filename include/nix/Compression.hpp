@@ -8,16 +8,173 @@
 #ifndef I_COMPRESSION_H
 #define I_COMPRESSION_H
 
+#include <nix/Platform.hpp>
+
+#include <vector>
+
 namespace nix {
 
 /**
- * @brief Data Compression modes
+ * @brief Data Compression settings
+ *
+ * Describes the filters that are applied to the data of a DataArray or
+ * DataFrame when it is stored. A codec (deflate or a filter plugin) can be
+ * combined with the byte shuffle filter, the scale-offset filter for integer
+ * data and Fletcher32 checksums:
+ *
+ * @code
+ * Compression c = Compression::deflate(4).shuffle(true).fletcher32(true);
+ * @endcode
+ *
+ * The former compression modes are available as Compression::None,
+ * Compression::DeflateNormal (deflate with level 6) and Compression::Auto.
+ * Auto means that the compression of the file is used; if that is Auto as
+ * well, the settings are chosen based on the data type and the shape of
+ * the data.
  */
-enum class Compression {
-    None = 0,
-    DeflateNormal,
-    Auto
+class NIXAPI Compression {
+public:
+
+    enum class Codec {
+        None = 0,
+        Deflate,
+        Filter,
+        Auto
+    };
+
+    /**
+     * @brief Filter ids of some registered filter plugins, see
+     *        https://portal.hdfgroup.org/display/support/Filters
+     */
+    static const unsigned FilterBlosc = 32001;
+    static const unsigned FilterLZ4 = 32004;
+    static const unsigned FilterZstd = 32015;
+
+    static const Compression None;
+    static const Compression DeflateNormal;
+    static const Compression Auto;
+
+    /**
+     * @brief No compression.
+     */
+    Compression()
+        : cdc(Codec::None), lvl(0), id(0), shuffle_bytes(false), checksum(false), min_bits(-1) {}
+
+    /**
+     * @brief Deflate (zlib) compression.
+     *
+     * @param level     The compression level from 0 (none) to 9 (best).
+     */
+    static Compression deflate(unsigned level = 6);
+
+    /**
+     * @brief Compression with a registered filter plugin, e.g. LZ4 or Zstd.
+     *
+     * Plugins are loaded by HDF5 at runtime. If the filter is not available
+     * when the data is created, deflate with the given fallback level is used
+     * instead, such that the data can be read everywhere.
+     *
+     * @param filter_id         The registered id of the filter, e.g. FilterZstd.
+     * @param params            The parameters (cd_values) of the filter.
+     * @param fallback_level    The deflate level to use if the filter is not available.
+     */
+    static Compression filter(unsigned filter_id, std::vector<unsigned> params = {}, unsigned fallback_level = 6);
+
+    Codec codec() const {
+        return cdc;
+    }
+
+    /**
+     * @brief The deflate level, for filters the fallback level.
+     */
+    unsigned level() const {
+        return lvl;
+    }
+
+    unsigned filterId() const {
+        return id;
+    }
+
+    const std::vector<unsigned> &filterParams() const {
+        return params;
+    }
+
+    bool shuffle() const {
+        return shuffle_bytes;
+    }
+
+    /**
+     * @brief Reorder the bytes of the values before compressing them, which
+     *        usually improves the compression of numeric data.
+     */
+    Compression &shuffle(bool enable) {
+        shuffle_bytes = enable;
+        return *this;
+    }
+
+    bool fletcher32() const {
+        return checksum;
+    }
+
+    /**
+     * @brief Store a Fletcher32 checksum with every chunk.
+     */
+    Compression &fletcher32(bool enable) {
+        checksum = enable;
+        return *this;
+    }
+
+    /**
+     * @brief The number of bits kept by the scale-offset filter, 0 if
+     *        the library determines it, -1 if the filter is disabled.
+     */
+    int scaleOffset() const {
+        return min_bits;
+    }
+
+    /**
+     * @brief Use the lossless scale-offset filter for integer data, which
+     *        stores the values relative to the minimum with as few bits as
+     *        needed. It is ignored for all other data types.
+     *
+     * @param minbits   The number of bits to keep, 0 to let the library
+     *                  determine it, -1 to disable the filter.
+     */
+    Compression &scaleOffset(int minbits) {
+        min_bits = minbits < 0 ? -1 : minbits;
+        return *this;
+    }
+
+    /**
+     * @brief Whether any filter is applied.
+     */
+    bool enabled() const {
+        return cdc == Codec::Deflate || cdc == Codec::Filter || shuffle_bytes || checksum || min_bits >= 0;
+    }
+
+    bool operator==(const Compression &other) const {
+        return cdc == other.cdc && lvl == other.lvl && id == other.id && params == other.params &&
+               shuffle_bytes == other.shuffle_bytes && checksum == other.checksum && min_bits == other.min_bits;
+    }
+
+    bool operator!=(const Compression &other) const {
+        return !(*this == other);
+    }
+
+private:
+
+    explicit Compression(Codec codec, unsigned level = 0)
+        : cdc(codec), lvl(level), id(0), shuffle_bytes(false), checksum(false), min_bits(-1) {}
+
+    Codec cdc;
+    unsigned lvl;
+    unsigned id;
+    std::vector<unsigned> params;
+    bool shuffle_bytes;
+    bool checksum;
+    int min_bits;
 };
+
 }
 
 #endif // NIX_COMPRESSION_H
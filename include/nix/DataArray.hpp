@@ -543,6 +543,78 @@ public:
         backend()->write(dtype, data, count, offset);
     }
 
+    /**
+     * @brief Read data like getData, but decompress the data on several threads.
+     *
+     * For deflate compressed data the chunks are read raw and decompressed
+     * and copied into data on the given number of threads. In all other cases
+     * this is the same as getData. Polynomial and expansion origin are applied.
+     *
+     * @param dtype     The type of data to read.
+     * @param data      Buffer for count.nelms() values.
+     * @param count     The size of the data to read.
+     * @param offset    The position where the reading should start.
+     * @param threads   The number of threads, 0 for one per core.
+     */
+    void getDataParallel(DataType dtype,
+                         void *data,
+                         const NDSize &count,
+                         const NDSize &offset,
+                         size_t threads = 0) const;
+
+    /**
+     * @brief Read data into value like getData, but decompress the data on
+     *        several threads, see getDataParallel(DataType, void*, const NDSize&, const NDSize&, size_t).
+     */
+    template<typename T>
+    void getDataParallel(T &value, const NDSize &count, const NDSize &offset, size_t threads = 0) const {
+        Hydra<T> hydra(value);
+        DataType dtype = hydra.element_data_type();
+
+        hydra.resize(count);
+        getDataParallel(dtype, hydra.data(), count, offset, threads);
+    }
+
+    /**
+     * @brief Write data like setData, but compress the data on several threads.
+     *
+     * For deflate compressed data the chunks that are completely covered by
+     * count and offset are compressed on the given number of threads and
+     * written directly, the result is the same as with the regular filter
+     * pipeline. The remaining data, and all data that has to be converted to
+     * the type of the DataArray, is written as with setData.
+     *
+     * @param dtype     The type of data to write.
+     * @param data      The count.nelms() values to write.
+     * @param count     The size of the data to write.
+     * @param offset    The position where the writing should start.
+     * @param threads   The number of threads, 0 for one per core.
+     */
+    void setDataParallel(DataType dtype,
+                         const void *data,
+                         const NDSize &count,
+                         const NDSize &offset,
+                         size_t threads = 0) {
+        backend()->writeParallel(dtype, data, count, offset, threads);
+    }
+
+    /**
+     * @brief Read several slabs of the data with a single read operation.
+     *
+     * The slabs must not overlap and must follow each other in the order
+     * the data is stored, the data of all slabs is written to data one after
+     * another. Polynomial and expansion origin are applied as for getData.
+     *
+     * @param dtype     The type of data to read.
+     * @param data      Buffer large enough for the data of all slabs.
+     * @param counts    The size of each slab.
+     * @param offsets   The position of each slab.
+     */
+    void getSlabs(DataType dtype,
+                  void *data,
+                  const std::vector<NDSize> &counts,
+                  const std::vector<NDSize> &offsets) const;
+
 
     /**
      * @brief Get the extent of the data of the DataArray entity.
@@ -562,6 +634,35 @@ public:
         backend()->dataExtent(extent);
     }
 
+    /**
+     * @brief Get the shape of the chunks the data is stored in.
+     *
+     * @return The chunk shape, empty if the data is not stored in chunks.
+     */
+    NDSize chunking() const {
+        return backend()->chunking();
+    }
+
+    /**
+     * @brief Configure the cache for decompressed chunks used when accessing
+     *        the data through this DataArray object, instead of the
+     *        configuration of the file. The setting is not stored in the file.
+     *
+     * @param cache     The chunk cache configuration.
+     */
+    void chunkCache(const ChunkCache &cache) {
+        backend()->chunkCache(cache);
+    }
+
+    /**
+     * @brief Get the chunk cache configuration in effect for this DataArray.
+     *
+     * @return The chunk cache configuration.
+     */
+    ChunkCache chunkCache() const {
+        return backend()->chunkCache();
+    }
+
     /**
      * @brief Get the data type of the data stored in the DataArray entity.
      *
@@ -571,7 +672,16 @@ public:
         return backend()->dataType();
     }
 
-    void appendData(DataType dtype, const void *data, const NDSize &count, size_t axis);
+    /**
+     * @brief Append data along the given axis, enlarging the DataArray.
+     *
+     * @param dtype     The type of data to append.
+     * @param data      The data to append.
+     * @param count     The size of the data, must match the extent of the DataArray in all but axis.
+     * @param axis      The dimension along which the data is appended.
+     * @param threads   The number of threads used for compression, see setDataParallel.
+     */
+    void appendData(DataType dtype, const void *data, const NDSize &count, size_t axis, size_t threads = 1);
 
     //--------------------------------------------------
     // Other methods and functions
@@ -610,6 +720,8 @@ protected:
                  const void *data,
                  const NDSize &count,
                  const NDSize &offset);
+
+    void ioReadStrided(const DataSpan &span, const NDSize &offset) const;
 };
 
 
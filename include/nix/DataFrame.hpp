@@ -19,6 +19,7 @@
 
 #include <nix/Hydra.hpp>
 
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -39,6 +40,15 @@ public:
         : EntityWithSources(std::move(ptr))
         {}
 
+    /**
+     * @brief How the table is stored, see nix::DataFrameLayout.
+     *
+     * @return The layout chosen when the DataFrame was created.
+     */
+    DataFrameLayout layout() const {
+        return backend()->layout();
+    }
+
     /**
      * @brief Returns the number of rows in the DataFrame.
      *
@@ -117,9 +127,43 @@ public:
      * @param v       std::vector of nix::Variant objects
      */
     void writeRow(ndsize_t row, const std::vector<Variant> &v) {
+        if (row >= this->rows()) {
+            throw OutOfBounds("Trying to write a row beyond the end of the DataFrame");
+        }
         return backend()->writeRow(row, v);
     }
 
+    /**
+     * @brief Write many complete rows at once, overwriting any existing data.
+     *
+     * Consecutive rows whose values have the same types are written
+     * together, which is much faster than writing them one by one.
+     *
+     * @param offset  Index of the first row to write to.
+     * @param rows    The rows, each a std::vector of nix::Variant objects.
+     */
+    void writeRows(ndsize_t offset, const std::vector<std::vector<Variant>> &rows) {
+        if (offset + rows.size() > this->rows()) {
+            throw OutOfBounds("Trying to write rows beyond the end of the DataFrame");
+        }
+        return backend()->writeRows(offset, rows);
+    }
+
+    /**
+     * @brief Append rows at the end of the DataFrame.
+     *
+     * The storage grows geometrically, so appending many small batches
+     * needs only a few resize operations. Any capacity beyond the last row
+     * is released when the file is flushed or closed.
+     *
+     * @param rows    The rows, each a std::vector of nix::Variant objects.
+     *
+     * @return The index of the first appended row.
+     */
+    ndsize_t appendRows(const std::vector<std::vector<Variant>> &rows) {
+        return backend()->appendRows(rows);
+    }
+
     /**
      * @brief Write a single cell.
      *
@@ -140,6 +184,9 @@ public:
      *                in the cell object.
      */
     void writeCells(ndsize_t row, const std::vector<Cell> &cells) {
+        if (row >= this->rows()) {
+            throw OutOfBounds("Trying to write cells beyond the end of the DataFrame");
+        }
         return backend()->writeCells(row, cells);
     }
 
@@ -336,6 +383,144 @@ public:
         const std::string name = this->colName(col);
         readColumn(name, vals, count, resize, offset);
     }
+
+    /**
+     * @brief Read the data of several columns at once.
+     *
+     * The requested columns are read together in a single pass over the
+     * rows, which is much faster than reading them one by one, especially
+     * for tables with many columns. Every vector is resized to count.
+     *
+     * @code
+     * std::vector<double> time;
+     * std::vector<int32_t> trial;
+     * df.readColumns({"time", "trial"}, 0, df.rows(), time, trial);
+     * @endcode
+     *
+     * @param names   The names of the columns to read.
+     * @param offset  Which row to start reading.
+     * @param count   How many rows to read.
+     * @param vals    One std::vector per column to store the data in.
+     */
+    template<typename... T>
+    void readColumns(const std::vector<std::string> &names,
+                     ndsize_t offset,
+                     size_t count,
+                     std::vector<T> &... vals) {
+        if (names.size() != sizeof...(T)) {
+            throw std::invalid_argument("readColumns: need one vector per column");
+        }
+        if (offset + count > rows()) {
+            throw OutOfBounds("Trying to read rows beyond the end of the DataFrame");
+        }
+
+        std::vector<DataType> dtypes = {Hydra<std::vector<T>>(vals).element_data_type()...};
+        std::vector<void *> data = {columnStorage(vals, count)...};
+        backend()->readColumns(names, offset, count, dtypes, data);
+    }
+
+    /**
+     * @brief Select the rows that satisfy all of the given conditions.
+     *
+     * Only the columns used in the conditions are read, together and in
+     * blocks of rows. The values of a column are compared as doubles if
+     * the column or any value it is compared with is a floating point
+     * number, as integers otherwise. Strings can only be compared with
+     * strings.
+     *
+     * @code
+     * std::vector<ndsize_t> hits = df.filter({{"stim", Condition::Op::Equal, 3},
+     *                                         {"rt", Condition::Op::Less, 0.5}});
+     * @endcode
+     *
+     * @param conditions  The conditions, all rows are selected if empty.
+     *
+     * @return The indices of the selected rows in ascending order.
+     */
+    std::vector<ndsize_t> filter(const std::vector<Condition> &conditions) const;
+
+    /**
+     * @brief Select the rows that satisfy all of the given conditions.
+     *
+     * @param conditions  The conditions, see filter().
+     *
+     * @return One entry per row that is true if the row is selected.
+     */
+    std::vector<bool> filterMask(const std::vector<Condition> &conditions) const;
+
+    /**
+     * @brief Create a sorted index of a column, or rebuild it.
+     *
+     * The index is stored with the DataFrame and makes lookup() take
+     * logarithmic instead of linear time. Appended rows are merged into the
+     * index and writes of up to 16 rows move their entries, so both keep
+     * it up to date. Larger writes to the column mark the index as
+     * outdated; lookups then scan the column until the index is rebuilt by
+     * calling createIndex() again. Indexes can be created for numeric and
+     * string columns, and for several columns of the same DataFrame.
+     *
+     * @param name    The name of the column.
+     */
+    void createIndex(const std::string &name) {
+        backend()->createIndex(name);
+    }
+
+    /**
+     * @brief Whether the column has an index.
+     *
+     * @param name    The name of the column.
+     */
+    bool hasIndex(const std::string &name) const {
+        return backend()->hasIndex(name);
+    }
+
+    /**
+     * @brief Delete the index of a column.
+     *
+     * @param name    The name of the column.
+     *
+     * @return True if the column had an index.
+     */
+    bool deleteIndex(const std::string &name) {
+        return backend()->deleteIndex(name);
+    }
+
+    /**
+     * @brief Find the rows in which a column has the given value.
+     *
+     * Uses the index of the column if there is an up to date one, see
+     * createIndex(), and scans the column otherwise. A lookup never writes
+     * to the file. Values are compared as in filter().
+     *
+     * @param name    The name of the column.
+     * @param value   The value to look for.
+     *
+     * @return The indices of the rows in ascending order.
+     */
+    std::vector<ndsize_t> lookup(const std::string &name, const Variant &value) const {
+        return lookup(name, value, value);
+    }
+
+    /**
+     * @brief Find the rows in which the value of a column lies in a range.
+     *
+     * @param name    The name of the column.
+     * @param lower   The smallest value of the range.
+     * @param upper   The largest value of the range.
+     *
+     * @return The indices of the rows with lower <= value <= upper in
+     *         ascending order.
+     */
+    std::vector<ndsize_t> lookup(const std::string &name, const Variant &lower, const Variant &upper) const;
+
+private:
+
+    template<typename T>
+    static void *columnStorage(std::vector<T> &vals, size_t count) {
+        vals.resize(count);
+        Hydra<std::vector<T>> hydra(vals);
+        return hydra.data();
+    }
 };
 
 
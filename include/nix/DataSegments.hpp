@@ -0,0 +1,89 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_DATA_SEGMENTS_H
+#define NIX_DATA_SEGMENTS_H
+
+#include <nix/NDSize.hpp>
+#include <nix/Exception.hpp>
+#include <nix/Platform.hpp>
+
+#include <vector>
+
+namespace nix {
+
+/**
+ * @brief Several segments of the data of a {@link nix::DataArray} that
+ *        were read into one buffer.
+ *
+ * Each segment is a view into the shared buffer: the data of segment i
+ * starts at data(i) and holds count(i).nelms() values in row-major order.
+ * Segments that overlap in the DataArray share their values in the buffer.
+ * The values are always read as double.
+ */
+class NIXAPI DataSegments {
+public:
+
+    DataSegments() {}
+
+    DataSegments(std::vector<double> buffer, std::vector<NDSize> offsets,
+                 std::vector<NDSize> counts, std::vector<size_t> starts)
+        : values(std::move(buffer)), offsets(std::move(offsets)),
+          counts(std::move(counts)), starts(std::move(starts)) {
+
+        if (this->offsets.size() != this->starts.size() || this->counts.size() != this->starts.size()) {
+            throw std::invalid_argument("DataSegments: number of offsets, counts and starts must match");
+        }
+    }
+
+    /**
+     * @brief The number of segments.
+     */
+    size_t size() const {
+        return starts.size();
+    }
+
+    /**
+     * @brief The offset of the segment in the DataArray.
+     */
+    const NDSize &offset(size_t index) const {
+        return offsets.at(index);
+    }
+
+    /**
+     * @brief The shape of the segment.
+     */
+    const NDSize &count(size_t index) const {
+        return counts.at(index);
+    }
+
+    /**
+     * @brief Pointer to the first value of the segment.
+     */
+    const double *data(size_t index) const {
+        return values.data() + starts.at(index);
+    }
+
+    /**
+     * @brief The buffer all segments point into.
+     */
+    const std::vector<double> &buffer() const {
+        return values;
+    }
+
+private:
+
+    std::vector<double> values;
+    std::vector<NDSize> offsets;
+    std::vector<NDSize> counts;
+    std::vector<size_t> starts;
+};
+
+} // namespace nix
+
+#endif // NIX_DATA_SEGMENTS_H
@@ -14,6 +14,7 @@
 
 #include <nix/Dimensions.hpp>
 #include <nix/Hydra.hpp>
+#include <nix/DataSpan.hpp>
 
 #include <nix/Platform.hpp>
 
@@ -46,6 +47,23 @@ public:
         ioWrite(dtype, data, count, offset);
     }
 
+    /**
+     * @brief Read data of the shape of span at offset directly into the
+     *        memory described by span.
+     */
+    void getData(const DataSpan &span, const NDSize &offset) const {
+        if (span.contiguous()) {
+            ioRead(span.dataType(), span.data(), span.shape(), offset);
+        } else {
+            ioReadStrided(span, offset);
+        }
+    }
+
+    // not the getData(T &value, offset) template
+    void getData(DataSpan &span, const NDSize &offset) const {
+        getData(static_cast<const DataSpan &>(span), offset);
+    }
+
     // *** the virtual interface ***
     virtual void dataExtent(const NDSize &extent) = 0;
     virtual NDSize dataExtent() const = 0;
@@ -65,6 +83,14 @@ protected:
                          const NDSize &count,
                          const NDSize &offset) = 0;
 
+    // reads into a temporary buffer and copies the data into the span
+    virtual void ioReadStrided(const DataSpan &span, const NDSize &offset) const {
+        std::vector<char> buffer(check::fits_in_size_t(span.shape().nelms() * data_type_to_size(span.dataType()),
+                                                       "DataSet::getData: data exceeds memory"));
+        ioRead(span.dataType(), buffer.data(), span.shape(), offset);
+        span.scatter(buffer.data());
+    }
+
 };
 
 template<typename T>
@@ -0,0 +1,99 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_DATA_SPAN_H
+#define NIX_DATA_SPAN_H
+
+#include <nix/DataType.hpp>
+#include <nix/NDSize.hpp>
+#include <nix/Platform.hpp>
+
+namespace nix {
+
+/**
+ * @brief Memory owned by the caller that data is read into.
+ *
+ * A span is a pointer to the first element, the type and the shape of the
+ * data, and optionally the strides: the distance between two consecutive
+ * elements of every dimension, counted in elements. Without strides the
+ * data is dense and in row-major order. A span can be reused for many
+ * reads, nothing is allocated or resized by the library:
+ *
+ * @code
+ * std::vector<float> frame(512 * 512);
+ * DataSpan span(frame.data(), {1, 512, 512});
+ * for (ndsize_t i = 0; i < n; i++) {
+ *     array.getData(span, {i, 0, 0});
+ *     process(frame);
+ * }
+ * @endcode
+ *
+ * Strided spans, e.g. every other column of a matrix or a region of a larger
+ * image, are read without an intermediate copy if every stride is a multiple
+ * of the next one and the rows do not overlap (see nested()). Other layouts
+ * are read into a temporary buffer first.
+ */
+class NIXAPI DataSpan {
+public:
+
+    /**
+     * @param dtype     The type of the elements, strings are not supported.
+     * @param data      Pointer to the first element.
+     * @param shape     The shape of the data.
+     * @param strides   The strides of every dimension in elements, dense row-major if empty.
+     */
+    DataSpan(DataType dtype, void *data, NDSize shape, NDSize strides = {});
+
+    template<typename T>
+    DataSpan(T *data, NDSize shape, NDSize strides = {})
+        : DataSpan(to_data_type<T>::value, data, std::move(shape), std::move(strides)) {}
+
+    DataType dataType() const {
+        return dtype;
+    }
+
+    void *data() const {
+        return ptr;
+    }
+
+    const NDSize &shape() const {
+        return dims;
+    }
+
+    const NDSize &strides() const {
+        return steps;
+    }
+
+    /**
+     * @brief Whether the elements are dense and in row-major order.
+     */
+    bool contiguous() const;
+
+    /**
+     * @brief Whether every stride is a multiple of the next one and the
+     *        elements along each dimension fit between two steps of the
+     *        previous dimension. Such spans can be read into directly.
+     */
+    bool nested() const;
+
+    /**
+     * @brief Copy dense row-major data of the span's shape into the span.
+     */
+    void scatter(const void *source) const;
+
+private:
+
+    DataType dtype;
+    void *ptr;
+    NDSize dims;
+    NDSize steps;
+};
+
+} // namespace nix
+
+#endif // NIX_DATA_SPAN_H
@@ -13,6 +13,10 @@
 
 #include <nix/DataArray.hpp>
 
+#include <functional>
+#include <utility>
+#include <vector>
+
 namespace nix {
 
 class NIXAPI DataView : public DataSet {
@@ -47,16 +51,101 @@ protected:
                  const NDSize &count,
                  const NDSize &offset);
 
-private:
+    void ioReadStrided(const DataSpan &span, const NDSize &offset) const;
+
     NDSize transform_coordinates(const NDSize &c, const NDSize &o) const;
 
-private:
     DataArray array;
     NDSize    offset;
     NDSize    count;
 
 };
 
+
+/**
+ * @brief A DataView that keeps the data in the type it is stored with and
+ *        applies the calibration of the DataArray only on demand.
+ *
+ * getData returns calibrated values like for any DataView. In addition the
+ * raw values and the calibration parameters are available, and the view can
+ * be processed block by block with forEachBlock or reduced with range and
+ * crossings, without ever holding all calibrated values in memory.
+ *
+ * The calibration is read when the view is created.
+ */
+class NIXAPI CalibratedView : public DataView {
+public:
+
+    typedef std::function<void(const double *values, const NDSize &count, const NDSize &offset)> BlockFunction;
+
+    CalibratedView(DataArray da, NDSize count, NDSize offset);
+
+    /**
+     * @brief A view of all data of the array.
+     */
+    explicit CalibratedView(const DataArray &da);
+
+    const std::vector<double> &polynomCoefficients() const {
+        return coefficients;
+    }
+
+    double expansionOrigin() const {
+        return origin;
+    }
+
+    /**
+     * @brief Read the uncalibrated values, count and offset are relative to the view.
+     */
+    void getRawData(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const;
+
+    /**
+     * @brief Apply the calibration to a single raw value.
+     */
+    double calibrate(double raw) const;
+
+    /**
+     * @brief Call fn with the calibrated values of consecutive blocks of the view.
+     *
+     * The view is split along its first dimension into blocks of at most
+     * max_elements values (at least one slice). fn gets the values in
+     * row-major order, the shape of the block and its offset in the view.
+     * The buffer is reused for the next block.
+     *
+     * @param fn            The function called for every block.
+     * @param max_elements  The maximum number of values per block.
+     */
+    void forEachBlock(const BlockFunction &fn, ndsize_t max_elements = 65536) const;
+
+    /**
+     * @brief The minimum and maximum of the calibrated values, NaN are ignored.
+     *
+     * For linear calibrations the extremes of the raw values are calibrated.
+     */
+    std::pair<double, double> range() const;
+
+    /**
+     * @brief The indices at which the calibrated values of a one-dimensional
+     *        view cross the threshold.
+     *
+     * A rising crossing at i means that value i - 1 is below and value i is
+     * at or above the threshold; falling crossings are found the other way round.
+     *
+     * @param threshold     The threshold in calibrated units.
+     * @param rising        Whether to find rising or falling crossings.
+     *
+     * @return The indices relative to the view.
+     */
+    std::vector<ndsize_t> crossings(double threshold, bool rising = true) const;
+
+private:
+
+    void forEachRawBlock(const std::function<void(const void *, DataType, size_t, const NDSize &, const NDSize &)> &fn,
+                         ndsize_t max_elements) const;
+
+    std::vector<double> coefficients;
+    double origin;
+};
+
 } // nix::
 
 #endif // DATA_VIEW_HPP
\ No newline at end of file
@@ -358,6 +358,24 @@ public:
                                                                         const std::vector<double> &end_positions,
                                                                         const RangeMatch match) const;
 
+    /**
+     * @brief Batch version of {@link SampledDimension::indexOf(const std::vector<double>&, const std::vector<double>&, const RangeMatch)}
+     *        that writes the results into flat arrays instead of a vector of optionals.
+     *
+     * @param start_positions    Vector of start positions
+     * @param end_positions      Vector of end positions
+     * @param match              RangeMatch enum to control whether the range should be
+     *                           including the end position or exclusive, i.e. without
+     *                           the end position.
+     * @param start_indices      Output, the start index of each range.
+     * @param end_indices        Output, the end index of each range.
+     * @param valid              Output, 1 if the respective range is valid, 0 otherwise.
+     *                           Start and end index of invalid ranges are undefined.
+     */
+    void indexOf(const std::vector<double> &start_positions, const std::vector<double> &end_positions,
+                 const RangeMatch match, std::vector<ndsize_t> &start_indices,
+                 std::vector<ndsize_t> &end_indices, std::vector<char> &valid) const;
+
     /**
      * @deprecated This function has been deprecated please use
      *             {@link SampledDimension::indexOf(const std::vector<double>&, const std::vector<double>&, const RangeMatch)} instead
@@ -602,6 +620,34 @@ class NIXAPI DataFrameDimension : public base::ImplContainer<base::IDataFrameDim
         df.readColumn(*column_index, ticks, true, offset);
     }
 
+    /**
+     * @brief The indices at which the column has the given value.
+     *
+     * Uses the index of the column if the DataFrame has one, see
+     * {@link nix::DataFrame::createIndex}.
+     *
+     * @param value      The value to look for.
+     * @param col_index  The index of the DataFrame column, the default
+     *                   column of the dimension if not given.
+     *
+     * @return The indices in ascending order.
+     */
+    std::vector<ndsize_t> lookup(const Variant &value, boost::optional<unsigned> col_index = {}) const {
+        return lookup(value, value, col_index);
+    }
+
+    /**
+     * @brief The indices at which the value of the column lies in a range.
+     *
+     * @param lower      The smallest value of the range.
+     * @param upper      The largest value of the range.
+     * @param col_index  The index of the DataFrame column, the default
+     *                   column of the dimension if not given.
+     *
+     * @return The indices with lower <= value <= upper in ascending order.
+     */
+    std::vector<ndsize_t> lookup(const Variant &lower, const Variant &upper, boost::optional<unsigned> col_index = {}) const;
+
     /**
     * @brief returns the index in this dimension that matches the given position. 
     * 
@@ -1112,6 +1158,21 @@ public:
     boost::optional<ndsize_t> indexOf(const double position, PositionMatch matching) const;
 
 
+    /**
+     * @brief Returns the indices of the given positions.
+     *
+     * Same as {@link indexOf(const double, PositionMatch)} for each position,
+     * but the ticks are loaded only once for all positions.
+     *
+     * @param positions The positions.
+     * @param matching  PositionMatch enum entry that defines the matching
+     *                  behavior.
+     *
+     * @return vector of boost optionals containing the indices if valid.
+     */
+    std::vector<boost::optional<ndsize_t>> indexOf(const std::vector<double> &positions, PositionMatch matching) const;
+
+
     /**
      * @brief Returns the start and end index of the given start and end
      * positions.  By default, the range includes the end position. This can be
@@ -86,14 +86,18 @@ public:
      * @param impl          The back-end implementation to be used to open the file.
      *                      (currently only hdf5)
      * @param compression   The compression mode, defaults to Compression::None (can be
-     *                      overridden upon DataArray creation)
+     *                      overridden upon DataArray creation). With Compression::Auto
+     *                      the compression is chosen for each DataArray and DataFrame
+     *                      based on its data type and shape.
      * @param flags         Control aspects of the file opening process
+     * @param cache         The configuration of the chunk cache of all DataArrays
+     *                      (can be overridden for each DataArray)
      *
      * @return The opened file.
      */
     static File open(const std::string &name, FileMode mode=FileMode::ReadWrite,
-                     const std::string &impl="hdf5", Compression compression=Compression::Auto,
-                     OpenFlags flags=OpenFlags::None);
+                     const std::string &impl="hdf5", Compression compression=Compression::None,
+                     OpenFlags flags=OpenFlags::None, const ChunkCache &cache=ChunkCache());
 
     /**
      * @brief Persists all cached changes to the backend.
@@ -503,6 +507,13 @@ public:
         return backend()->compression();
     }
 
+    /**
+     * @brief Returns the chunk cache configuration selected when the file was opened.
+     */
+    ChunkCache chunkCache() const {
+        return backend()->chunkCache();
+    }
+
     /**
      * @brief Assignment operator for none.
      */
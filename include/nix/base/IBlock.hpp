@@ -16,6 +16,7 @@
 #include <nix/base/ITag.hpp>
 #include <nix/base/IMultiTag.hpp>
 #include <nix/base/IGroup.hpp>
+#include <nix/AccessHint.hpp>
 #include <nix/Compression.hpp>
 #include <nix/NDSize.hpp>
 #include <nix/Identity.hpp>
@@ -78,7 +79,8 @@ public:
 
     virtual std::shared_ptr<base::IDataArray> createDataArray(const std::string &name, const std::string &type,
                                                               DataType data_type, const NDSize &shape,
-                                                              const Compression &compression) = 0;
+                                                              const Compression &compression,
+                                                              const AccessHint &hint) = 0;
 
     //--------------------------------------------------
     // Methods concerning data frame
@@ -87,7 +89,8 @@ public:
     virtual std::shared_ptr<base::IDataFrame> createDataFrame(const std::string &name,
                                                               const std::string &type,
                                                               const std::vector<Column> &cols,
-                                                              const Compression &compression) = 0;
+                                                              const Compression &compression,
+                                                              DataFrameLayout layout) = 0;
 
     //--------------------------------------------------
     // Methods concerning tags.
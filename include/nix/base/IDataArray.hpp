@@ -12,6 +12,8 @@
 #include <nix/base/IEntityWithSources.hpp>
 #include <nix/base/IDimensions.hpp>
 #include <nix/DataFrame.hpp>
+#include <nix/AccessHint.hpp>
+#include <nix/ChunkCache.hpp>
 #include <nix/Compression.hpp>
 #include <nix/DataType.hpp>
 #include <nix/NDSize.hpp>
@@ -125,8 +127,27 @@ public:
      * @param dtype        The data type that should be stored in this data array.
      * @param size         The size of the data to store.
      * @param compression  En-/disables compression for this DataArray
+     * @param hint         How the data is going to be accessed, used to choose the chunking.
      */
-    virtual void createData(DataType dtype, const NDSize &size, const Compression &compression) = 0;
+    virtual void createData(DataType dtype, const NDSize &size, const Compression &compression,
+                            const AccessHint &hint) = 0;
+
+    /**
+     * @brief The shape of the chunks the data is stored in, empty if the
+     *        data is not stored in chunks.
+     */
+    virtual NDSize chunking() const = 0;
+
+    /**
+     * @brief Set the chunk cache configuration used when accessing the
+     *        data through this object, overrides the one of the file.
+     */
+    virtual void chunkCache(const ChunkCache &cache) = 0;
+
+    /**
+     * @brief The chunk cache configuration in effect.
+     */
+    virtual ChunkCache chunkCache() const = 0;
 
     /**
      * @brief Check if the data array has some data.
@@ -155,6 +176,63 @@ public:
      */
     virtual void read(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset) const = 0;
 
+    /**
+     * @brief Read several slabs of the data with a single read operation.
+     *
+     * The slabs must not overlap and must be ordered such that they follow
+     * each other in the order the data is stored, i.e. the data of all slabs
+     * ends up in buffer one after another. String data is not supported.
+     *
+     * @param dtype     The type of data to read (e.g. {@link nix::DataType::Double}).
+     * @param buffer    Buffer where the data is written.
+     * @param counts    The size of each slab.
+     * @param offsets   The position of each slab.
+     */
+    virtual void read(DataType dtype, void *buffer, const std::vector<NDSize> &counts,
+                      const std::vector<NDSize> &offsets) const = 0;
+
+    /**
+     * @brief Read data into strided memory.
+     *
+     * Every stride must be a multiple of the next one and the elements of a
+     * dimension must fit between two steps of the previous one, see
+     * {@link nix::DataSpan::nested}.
+     *
+     * @param dtype     The type of data to read (e.g. {@link nix::DataType::Int32}).
+     * @param buffer    Pointer to the first element.
+     * @param count     The size of the data to read.
+     * @param offset    The position where the reading should start.
+     * @param strides   The distance between consecutive elements of every dimension in buffer, in elements.
+     */
+    virtual void readStrided(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset,
+                             const NDSize &strides) const = 0;
+
+    /**
+     * @brief Read data from the data array using several threads to
+     *        decompress the data, if the backend supports that.
+     *
+     * @param dtype     The type of data to read (e.g. {@link nix::DataType::Int32}).
+     * @param buffer    Buffer where the data is written.
+     * @param count     The size of the data to read.
+     * @param offset    The position where the reading should start.
+     * @param threads   The number of threads, 0 for one per core.
+     */
+    virtual void readParallel(DataType dtype, void *buffer, const NDSize &count, const NDSize &offset,
+                              size_t threads) const = 0;
+
+    /**
+     * @brief Write data into the data array using several threads to
+     *        compress the data, if the backend supports that.
+     *
+     * @param dtype     The type of data to write (e.g. {@link nix::DataType::Int32}).
+     * @param data      The data to write.
+     * @param count     The size of the data to write.
+     * @param offset    The position where the writing should start.
+     * @param threads   The number of threads, 0 for one per core.
+     */
+    virtual void writeParallel(DataType dtype, const void *data, const NDSize &count, const NDSize &offset,
+                               size_t threads) = 0;
+
 
     virtual NDSize dataExtent(void) const = 0;
 
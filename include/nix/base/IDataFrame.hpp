@@ -88,11 +88,55 @@ struct Cell : public nix::Variant {
 };
 
 
+/**
+ * @brief How the table of a DataFrame is stored.
+ *
+ * Rows stores the rows as one compound data set, which is best for
+ * reading and writing whole rows. Columns stores every column as a data
+ * set of its own, so reading a few columns of a wide table only touches
+ * their data, and every column is compressed separately.
+ */
+enum class DataFrameLayout {
+    Rows, Columns
+};
+
+
+/**
+ * @brief A comparison of the values of a column with a constant,
+ *        used to select rows with {@link nix::DataFrame::filter}.
+ */
+struct Condition {
+
+    enum class Op {
+        Equal, NotEqual, Less, LessEqual, Greater, GreaterEqual
+    };
+
+    Condition(const std::string &name, Op op, const Variant &value) :
+        name(name), op(op), value(value)
+    {}
+
+    Condition(const std::string &name, Op op, const char *str) :
+        name(name), op(op), value(str)
+    {}
+
+    template<typename T>
+    Condition(const std::string &name, Op op, const T &value) :
+        name(name), op(op), value(value)
+    {}
+
+    std::string name;
+    Op op;
+    Variant value;
+};
+
+
 namespace base {
 
 class NIXAPI IDataFrame : virtual public base::IEntityWithSources {
 public:
 
+    virtual DataFrameLayout layout() const = 0;
+
     virtual nix::ndsize_t rows() const = 0;
     virtual void rows(nix::ndsize_t n) = 0;
 
@@ -107,6 +151,9 @@ public:
     virtual std::vector<Variant> readRow(ndsize_t row) const = 0;
     virtual void writeRow(ndsize_t row, const std::vector<Variant> &v) = 0;
 
+    virtual void writeRows(ndsize_t offset, const std::vector<std::vector<Variant>> &rows) = 0;
+    virtual ndsize_t appendRows(const std::vector<std::vector<Variant>> &rows) = 0;
+
     virtual std::vector<Cell> readCells(ndsize_t row, const std::vector<std::string> &names) const = 0;
     virtual void writeCells(ndsize_t row, const std::vector<Cell> &cells) = 0;
 
@@ -117,12 +164,28 @@ public:
                             DataType dtype,
                             void *data) const = 0;
 
+    virtual void readColumns(const std::vector<std::string> &names,
+                             ndsize_t offset,
+                             ndsize_t count,
+                             const std::vector<DataType> &dtypes,
+                             const std::vector<void *> &data) const = 0;
+
     virtual void writeColumn(const std::string &name,
                              ndsize_t offset,
                              ndsize_t count,
                              DataType dtype,
                              const void *data) = 0;
 
+    virtual void createIndex(const std::string &name) = 0;
+    virtual bool hasIndex(const std::string &name) const = 0;
+    virtual bool deleteIndex(const std::string &name) = 0;
+
+    virtual bool lookup(const std::string &name,
+                        DataType dtype,
+                        const void *lower,
+                        const void *upper,
+                        std::vector<ndsize_t> &rows) const = 0;
+
 };
 
 }
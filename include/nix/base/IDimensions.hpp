@@ -19,6 +19,7 @@
 #include <ostream>
 
 #include <boost/optional.hpp>
+#include <memory>
 #include <nix/NDSize.hpp>
 #include <nix/ObjectType.hpp>
 
@@ -191,6 +192,23 @@ public:
 
     virtual void ticks(const std::vector<double> &ticks) = 0;
 
+    /**
+     * @brief All ticks of the dimension, read once and shared between calls
+     *        until they are changed through this dimension. Returns an empty
+     *        pointer if there are too many ticks to keep them in memory, use
+     *        {@link tickCount} and {@link lowerBound} to search them then.
+     */
+    virtual std::shared_ptr<const std::vector<double>> cachedTicks() const = 0;
+
+
+    virtual ndsize_t tickCount() const = 0;
+
+    /**
+     * @brief Index of the first tick that is not less than position or
+     *        tickCount() if there is no such tick.
+     */
+    virtual ndsize_t lowerBound(double position) const = 0;
+
 
     virtual ~IRangeDimension() {}
 
@@ -13,6 +13,7 @@
 #include <nix/base/IBlock.hpp>
 #include <nix/Platform.hpp>
 #include <nix/ObjectType.hpp>
+#include <nix/ChunkCache.hpp>
 #include <nix/Compression.hpp>
 
 #include <string>
@@ -34,8 +35,10 @@ enum class FileMode {
  * @brief Control the open process
  */
 enum class OpenFlags {
-    None  = 0,
-    Force = 1 << 0,
+    None    = 0,
+    Force   = 1 << 0,
+    IdIndex = 1 << 1,  // persist an entity id index in each block on flush/close
+    GrowExtents = 1 << 2,  // over-allocate data that grows along one axis, trim on flush/close
 };
 
 
@@ -154,6 +157,9 @@ public:
     virtual Compression compression() const = 0;
 
 
+    virtual ChunkCache chunkCache() const = 0;
+
+
     virtual ~IFile() {}
 
 };
@@ -0,0 +1,173 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_AGGREGATE_H
+#define NIX_AGGREGATE_H
+
+#include <nix/DataArray.hpp>
+#include <nix/MultiTag.hpp>
+#include <nix/Platform.hpp>
+
+#include <memory>
+#include <vector>
+
+namespace nix {
+namespace util {
+
+/**
+ * @brief Base class of all reducers that can be used with {@link aggregateTaggedData}.
+ *
+ * A reducer is fed the data of one window after the other. When windows
+ * are processed in parallel, every thread works on its own copy obtained
+ * from empty() and the copies are combined with merge() at the end.
+ */
+class NIXAPI Reducer {
+public:
+
+    /**
+     * @brief Add the values of one window, given in row-major order.
+     */
+    virtual void add(const double *values, size_t count) = 0;
+
+    /**
+     * @brief Add everything that was accumulated by other, which is
+     *        a reducer of the same type obtained from empty().
+     */
+    virtual void merge(const Reducer &other) = 0;
+
+    /**
+     * @brief A new reducer with the same configuration but without any data.
+     */
+    virtual std::unique_ptr<Reducer> empty() const = 0;
+
+    virtual ~Reducer() {}
+};
+
+
+/**
+ * @brief Element-wise statistics across windows, e.g. the event-triggered
+ *        average of a signal.
+ *
+ * For every element of the windows the number of values, the sum, the mean,
+ * the variance and the minimum and maximum are tracked. Mean and variance
+ * are accumulated with Welford's algorithm. Windows of different length are
+ * allowed, every element counts the windows that were long enough.
+ */
+class NIXAPI Statistics : public Reducer {
+public:
+
+    void add(const double *values, size_t count);
+
+    void merge(const Reducer &other);
+
+    std::unique_ptr<Reducer> empty() const;
+
+    /**
+     * @brief The number of windows that contributed to each element.
+     */
+    const std::vector<ndsize_t> &count() const {
+        return n;
+    }
+
+    std::vector<double> sum() const;
+
+    const std::vector<double> &mean() const {
+        return means;
+    }
+
+    /**
+     * @brief The sample variance (normalized by n - 1) of each element,
+     *        NaN for elements with less than two values.
+     */
+    std::vector<double> variance() const;
+
+    const std::vector<double> &min() const {
+        return mins;
+    }
+
+    const std::vector<double> &max() const {
+        return maxs;
+    }
+
+private:
+
+    void grow(size_t size);
+
+    std::vector<ndsize_t> n;
+    std::vector<double> means;
+    std::vector<double> m2;
+    std::vector<double> mins;
+    std::vector<double> maxs;
+};
+
+
+/**
+ * @brief Histogram of all values of all windows.
+ *
+ * The bins are given by their edges. A value x falls into bin i if
+ * edges[i] <= x < edges[i + 1], the last bin also includes its upper
+ * edge. Values outside of the edges are counted separately.
+ */
+class NIXAPI Histogram : public Reducer {
+public:
+
+    explicit Histogram(std::vector<double> edges);
+
+    void add(const double *values, size_t count);
+
+    void merge(const Reducer &other);
+
+    std::unique_ptr<Reducer> empty() const;
+
+    const std::vector<double> &edges() const {
+        return bin_edges;
+    }
+
+    const std::vector<ndsize_t> &counts() const {
+        return bin_counts;
+    }
+
+    /**
+     * @brief The number of values that are not within the edges.
+     */
+    ndsize_t outside() const {
+        return outside_count;
+    }
+
+private:
+
+    std::vector<double> bin_edges;
+    std::vector<ndsize_t> bin_counts;
+    ndsize_t outside_count;
+};
+
+
+/**
+ * @brief Feed the data tagged by the given positions and extents of a MultiTag
+ *        into a reducer, one window at a time.
+ *
+ * No DataViews are created and at most one window per thread is held in
+ * memory. Windows are read in the order in which they are stored. With more
+ * than one thread the reduction runs in parallel, while reading from the
+ * file is serialized.
+ *
+ * @param tag                   The multi tag.
+ * @param array                 The referenced DataArray.
+ * @param reducer               The reducer the windows are added to.
+ * @param position_indices      The indices of the positions, all positions if empty.
+ * @param match                 Controls the RangeMatch behavior, default is RangeMatch::Exclusive.
+ * @param threads               The number of threads to use, 0 to use one per core.
+ */
+NIXAPI void aggregateTaggedData(const MultiTag &tag, const DataArray &array, Reducer &reducer,
+                                std::vector<ndsize_t> position_indices = {},
+                                RangeMatch match = RangeMatch::Exclusive, size_t threads = 1);
+
+} // namespace util
+} // namespace nix
+
+#endif // NIX_AGGREGATE_H
@@ -0,0 +1,156 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#ifndef NIX_APPENDER_H
+#define NIX_APPENDER_H
+
+#include <nix/DataArray.hpp>
+#include <nix/Platform.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace nix {
+namespace util {
+
+/**
+ * @brief Appends a stream of data to a DataArray from a background thread.
+ *
+ * The producer hands over blocks of data with append() or tryAppend(). The
+ * data is copied into a ring buffer without taking any locks, a background
+ * thread writes it with DataArray::appendData whenever a whole chunk (or
+ * the given number of rows) is available. If the buffer is full, append()
+ * waits for the writer and tryAppend() returns false. flush() waits until
+ * everything appended so far has been written.
+ *
+ * A row is one slice of the data along the append axis, i.e. a block of n
+ * rows has the shape of the DataArray with n along the axis and is given in
+ * row-major order. Errors of the background thread are thrown by the next
+ * call to append(), tryAppend(), flush() or close().
+ *
+ * The DataArray must not be used by other threads while the appender is
+ * active unless the HDF5 library is thread-safe.
+ *
+ * @code
+ * util::DataArrayAppender appender(array, DataType::Int16, 1);
+ * while (acquiring) {
+ *     appender.append(samples, 30);  // 384 x 30 values
+ * }
+ * appender.close();
+ * @endcode
+ */
+class NIXAPI DataArrayAppender {
+public:
+
+    /**
+     * @brief Start appending to array.
+     *
+     * @param array         The DataArray, its extent defines the shape of the rows.
+     * @param dtype         The type of the data that is appended.
+     * @param axis          The dimension along which the data is appended.
+     * @param flush_rows    The number of rows written at once, 0 for one chunk.
+     * @param capacity      The number of rows the buffer holds, 0 for eight times flush_rows.
+     * @param threads       The number of threads used for compression, see DataArray::appendData.
+     */
+    DataArrayAppender(const DataArray &array, DataType dtype, size_t axis = 0,
+                      size_t flush_rows = 0, size_t capacity = 0, size_t threads = 1);
+
+    DataArrayAppender(const DataArrayAppender &other) = delete;
+
+    DataArrayAppender &operator=(const DataArrayAppender &other) = delete;
+
+    /**
+     * @brief Flushes the remaining data and stops the background thread,
+     *        errors are ignored. Call close() to see them.
+     */
+    ~DataArrayAppender();
+
+    /**
+     * @brief Append rows, waiting for the writer while the buffer is full.
+     *
+     * @param data      The data of all rows.
+     * @param rows      The number of rows.
+     */
+    void append(const void *data, size_t rows);
+
+    /**
+     * @brief Append rows if there is enough space in the buffer.
+     *
+     * @param data      The data of all rows.
+     * @param rows      The number of rows.
+     *
+     * @return False if the buffer is too full, nothing was appended then.
+     */
+    bool tryAppend(const void *data, size_t rows);
+
+    /**
+     * @brief Wait until all rows appended so far are written to the DataArray.
+     */
+    void flush();
+
+    /**
+     * @brief Flush and stop the background thread, no rows can be appended afterwards.
+     */
+    void close();
+
+    /**
+     * @brief The number of rows that are buffered but not written yet.
+     */
+    size_t pending() const {
+        return head.load() - tail.load();
+    }
+
+    /**
+     * @brief The number of rows the buffer can hold.
+     */
+    size_t capacity() const {
+        return slots;
+    }
+
+private:
+
+    void run();
+
+    void checkError();
+
+    void stop();
+
+    DataArray array;
+    DataType dtype;
+    NDSize row_shape;
+    size_t axis;
+    size_t outer;        // number of runs per row: product of the dimensions before axis
+    size_t inner_bytes;  // size of one run: product of the dimensions after axis
+    size_t flush_rows;
+    size_t slots;
+    size_t threads;
+
+    std::vector<char> ring;
+    std::vector<char> staging;
+    // rows [tail, head) are buffered, only the producer moves head, only the writer moves tail
+    std::atomic<size_t> head;
+    std::atomic<size_t> tail;
+    std::atomic<size_t> flush_target;
+    std::atomic<bool> stopping;
+    std::atomic<bool> failed;
+    std::exception_ptr error;
+
+    std::mutex wait_mutex;
+    std::condition_variable data_ready;
+    std::condition_variable space_ready;
+    std::thread writer;
+};
+
+} // namespace util
+} // namespace nix
+
+#endif // NIX_APPENDER_H
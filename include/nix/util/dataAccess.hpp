@@ -16,6 +16,7 @@
 
 #include <nix/NDArray.hpp>
 #include <nix/DataView.hpp>
+#include <nix/DataSegments.hpp>
 #include <nix/Dimensions.hpp>
 #include <nix/DataArray.hpp>
 #include <nix/MultiTag.hpp>
@@ -232,7 +233,7 @@ NIXAPI void getOffsetAndCount(const Tag &tag, const DataArray &array, NDSize &of
 NIXAPI void getOffsetAndCount(const MultiTag &tag, const DataArray &array, ndsize_t index, NDSize &offsets, NDSize &counts, RangeMatch match = RangeMatch::Inclusive);
 
 
-NIXAPI void getOffestAndCount(const MultiTag &tag, const DataArray &array, const std::vector<ndsize_t> indices,
+NIXAPI void getOffsetAndCount(const MultiTag &tag, const DataArray &array, const std::vector<ndsize_t> &indices,
                               std::vector<NDSize> &offsets, std::vector<NDSize> & counts, RangeMatch match = RangeMatch::Inclusive);
 
 
@@ -280,6 +281,36 @@ NIXAPI std::vector<DataView> taggedData(const MultiTag &tag, std::vector<ndsize_
  */
 NIXAPI std::vector<DataView> taggedData(const MultiTag &tag, std::vector<ndsize_t> &position_indices, ndsize_t reference_index, RangeMatch match = RangeMatch::Exclusive);
 
+/**
+ * @brief Read several segments of a DataArray into one buffer.
+ *
+ * If the segments differ in only one dimension, and all dimensions before that
+ * one are selected with a count of one, overlapping and adjacent segments are
+ * merged and everything is read with a single read operation. Otherwise the
+ * segments are read one after another into the buffer.
+ *
+ * @param array                 The DataArray.
+ * @param offsets               The offsets of the segments.
+ * @param counts                The shapes of the segments.
+ *
+ * @return The segments, as views into one buffer of doubles.
+ */
+NIXAPI DataSegments dataSegments(const DataArray &array, const std::vector<NDSize> &offsets, const std::vector<NDSize> &counts);
+
+/**
+ * @brief Retrieve the data segments tagged by the given positions and extents of the MultiTag
+ *        at once. Same as {@link taggedData(const MultiTag&, std::vector<ndsize_t>&, const DataArray&, RangeMatch)}
+ *        but reads all segments with as few read operations as possible, see {@link dataSegments}.
+ *
+ * @param tag                   The multi tag.
+ * @param position_indices      The indices of the positions, all positions if empty.
+ * @param array                 The referenced DataArray.
+ * @param match                 Controls the RangeMatch behavior, default is RangeMatch::Exclusive.
+ *
+ * @return The tagged segments, as views into one buffer of doubles.
+ */
+NIXAPI DataSegments taggedDataSegments(const MultiTag &tag, std::vector<ndsize_t> &position_indices, const DataArray &array, RangeMatch match = RangeMatch::Exclusive);
+
 /**
  * @brief Retrieve several data segments referenced by the given position and extent of the MultiTag.
  *
@@ -32,6 +32,7 @@
 namespace nix {
     
 enum class DimensionType : unsigned int;
+enum class DataType;
 
 namespace util {
 
@@ -424,6 +425,31 @@ NIXAPI void applyPolynomial(const std::vector<double> &coefficients,
                             double *output,
                             size_t n);
 
+/**
+ * @brief Apply polynomial and origin to values of one numeric type and
+ *        store the results as another numeric type in a single pass.
+ *
+ * The polynomial is evaluated in double precision. Results are converted
+ * to integer types like HDF5 does: truncated towards zero, clipped to the
+ * range of the type and 0 for NaN. input and output may be the same buffer
+ * if in_type and out_type are the same.
+ *
+ * @param coefficients  The coefficients of the polynomial, lowest order first.
+ * @param origin        The origin that is subtracted before.
+ * @param in_type       The type of the input values.
+ * @param input         The input values.
+ * @param out_type      The type of the output values.
+ * @param output        Buffer for n values of out_type.
+ * @param n             The number of values.
+ */
+NIXAPI void applyPolynomial(const std::vector<double> &coefficients,
+                            double origin,
+                            DataType in_type,
+                            const void *input,
+                            DataType out_type,
+                            void *output,
+                            size_t n);
+
 bool looksLikeUUID(const std::string &id);
 
 } // namespace util
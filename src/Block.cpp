@@ -46,12 +46,12 @@ bool Block::deleteSource(const Source &source) {
 }
 
 DataArray Block::createDataArray(const std::string &name, const std::string &type, nix::DataType data_type,
-                                 const NDSize &shape, const Compression &compression) {
+                                 const NDSize &shape, const Compression &compression, const AccessHint &hint) {
     util::checkEntityNameAndType(name, type);
     if (hasDataArray(name)){
         throw DuplicateName("create DataArray");
     }
-    return backend()->createDataArray(name, type, data_type, shape, compression);
+    return backend()->createDataArray(name, type, data_type, shape, compression, hint);
 }
 
 std::vector<DataArray> Block::dataArrays(const util::AcceptAll<DataArray>::type &filter) const {
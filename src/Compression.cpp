@@ -0,0 +1,42 @@
+// Copyright (c) 2017, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/Compression.hpp>
+
+#include <stdexcept>
+
+namespace nix {
+
+const unsigned Compression::FilterBlosc;
+const unsigned Compression::FilterLZ4;
+const unsigned Compression::FilterZstd;
+
+const Compression Compression::None = Compression();
+const Compression Compression::DeflateNormal = Compression(Compression::Codec::Deflate, 6);
+const Compression Compression::Auto = Compression(Compression::Codec::Auto);
+
+
+Compression Compression::deflate(unsigned level) {
+    if (level > 9) {
+        throw std::invalid_argument("Compression::deflate: level must be between 0 and 9");
+    }
+    return Compression(Codec::Deflate, level);
+}
+
+
+Compression Compression::filter(unsigned filter_id, std::vector<unsigned> params, unsigned fallback_level) {
+    if (fallback_level > 9) {
+        throw std::invalid_argument("Compression::filter: fallback level must be between 0 and 9");
+    }
+    Compression c(Codec::Filter, fallback_level);
+    c.id = filter_id;
+    c.params = std::move(params);
+    return c;
+}
+
+} // namespace nix
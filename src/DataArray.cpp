@@ -24,45 +24,96 @@ static void convertData(DataType source, DataType destination, void *data, size_
 }
 
 
-void DataArray::ioRead(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const {
-    const std::vector<double> poly = polynomCoefficients();
-    boost::optional<double> opt_origin = expansionOrigin();
+// Read nelms elements with the given read function and apply the polynomial
+// and the expansion origin of the array, if there are any. Numeric data is
+// read in the type it is stored with and calibrated into data in one pass.
+template<typename Reader>
+static void read_calibrated(const DataArray &array, DataType dtype, void *data, ndsize_t nelms, Reader read) {
+    const std::vector<double> poly = array.polynomCoefficients();
+    boost::optional<double> opt_origin = array.expansionOrigin();
 
     if (poly.size() || opt_origin) {
         size_t data_esize = data_type_to_size(dtype);
-        size_t nelms = check::fits_in_size_t(count.nelms(),
+        size_t n = check::fits_in_size_t(nelms,
 			"Cannot apply polynom or origin transform. Buffer needed exceeds memory.");
+        const double origin = opt_origin ? *opt_origin : 0.0;
+        const DataType stored = array.dataType();
+
+        if (data_type_is_numeric(dtype) && data_type_is_numeric(stored)) {
+            if (stored == dtype) {
+                read(dtype, data);
+                util::applyPolynomial(poly, origin, dtype, data, dtype, data, n);
+            } else {
+                std::vector<char> raw(n * data_type_to_size(stored));
+                read(stored, raw.data());
+                util::applyPolynomial(poly, origin, stored, raw.data(), dtype, data, n);
+            }
+            return;
+        }
+
         std::vector<double> tmp;
         double *read_buffer;
 
         if (data_esize < sizeof(double)) {
             //need temporary buffer
-            tmp.resize(nelms);
+            tmp.resize(n);
             read_buffer = tmp.data();
         } else {
             read_buffer = reinterpret_cast<double *>(data);
         }
 
-        getDataDirect(DataType::Double, read_buffer, count, offset);
-        const double origin = opt_origin ? *opt_origin : 0.0;
+        read(DataType::Double, read_buffer);
 
-        util::applyPolynomial(poly, origin, read_buffer, read_buffer, nelms);
-        convertData(DataType::Double, dtype, read_buffer, nelms);
+        util::applyPolynomial(poly, origin, read_buffer, read_buffer, n);
+        convertData(DataType::Double, dtype, read_buffer, n);
 
         if (tmp.size()) {
-            memcpy(data, read_buffer, nelms * data_esize);
+            memcpy(data, read_buffer, n * data_esize);
         }
 
     } else {
-        getDataDirect(dtype, data, count, offset);
+        read(dtype, data);
+    }
+}
+
+void DataArray::ioRead(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const {
+    read_calibrated(*this, dtype, data, count.nelms(), [&](DataType read_type, void *buffer) {
+        getDataDirect(read_type, buffer, count, offset);
+    });
+}
+
+void DataArray::getDataParallel(DataType dtype, void *data, const NDSize &count,
+                                const NDSize &offset, size_t threads) const {
+    read_calibrated(*this, dtype, data, count.nelms(), [&](DataType read_type, void *buffer) {
+        backend()->readParallel(read_type, buffer, count, offset, threads);
+    });
+}
+
+void DataArray::getSlabs(DataType dtype, void *data, const std::vector<NDSize> &counts,
+                         const std::vector<NDSize> &offsets) const {
+    ndsize_t nelms = 0;
+    for (const NDSize &count : counts) {
+        nelms += count.nelms();
     }
+    read_calibrated(*this, dtype, data, nelms, [&](DataType read_type, void *buffer) {
+        backend()->read(read_type, buffer, counts, offsets);
+    });
+}
+
+void DataArray::ioReadStrided(const DataSpan &span, const NDSize &offset) const {
+    // calibrated values are computed in a dense buffer anyway
+    if (!span.nested() || polynomCoefficients().size() || expansionOrigin()) {
+        DataSet::ioReadStrided(span, offset);
+        return;
+    }
+    backend()->readStrided(span.dataType(), span.data(), span.shape(), offset, span.strides());
 }
 
 void DataArray::ioWrite(DataType dtype, const void *data, const NDSize &count, const NDSize &offset) {
     setDataDirect(dtype, data, count, offset);
 }
 
-void DataArray::appendData(DataType dtype, const void *data, const NDSize &count, size_t axis) {
+void DataArray::appendData(DataType dtype, const void *data, const NDSize &count, size_t axis, size_t threads) {
 
     //first some sanity checks
     NDSize extent = dataExtent();
@@ -93,7 +144,11 @@ void DataArray::appendData(DataType dtype, const void *data, const NDSize &count
     //enlarge the DataArray to fit the new data
     dataExtent(extent);
 
-    setData(dtype, data, count, offset);
+    if (threads == 1) {
+        setData(dtype, data, count, offset);
+    } else {
+        setDataParallel(dtype, data, count, offset, threads);
+    }
 
 }
 
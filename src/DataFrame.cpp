@@ -8,4 +8,255 @@
 
 #include <nix/DataFrame.hpp>
 
+#include <algorithm>
+#include <functional>
+
 using namespace nix;
+
+namespace nix {
+
+// rows that are read and compared at once
+static const ndsize_t filter_block = 65536;
+
+typedef std::function<void(ndsize_t, const unsigned char *, size_t)> MaskFunction;
+
+
+static bool is_float(DataType dtype) {
+    return dtype == DataType::Float || dtype == DataType::Double;
+}
+
+
+static bool is_unsigned(DataType dtype) {
+    return dtype == DataType::UInt8 || dtype == DataType::UInt16 ||
+           dtype == DataType::UInt32 || dtype == DataType::UInt64;
+}
+
+
+// the type the values of a column are read as to compare them with value
+static DataType compare_type(DataType column, const Variant &value) {
+    const DataType vt = value.type();
+
+    if (column == DataType::String || vt == DataType::String) {
+        if (column != vt) {
+            throw std::invalid_argument("DataFrame::filter: strings can only be compared with strings");
+        }
+        return DataType::String;
+    }
+
+    if (column == DataType::Bool || vt == DataType::Bool) {
+        if (column != vt) {
+            throw std::invalid_argument("DataFrame::filter: booleans can only be compared with booleans");
+        }
+        return DataType::Bool;
+    }
+
+    if (!data_type_is_numeric(column) || !data_type_is_numeric(vt)) {
+        throw std::invalid_argument("DataFrame::filter: unsupported data type");
+    }
+
+    if (is_float(column) || is_float(vt)) {
+        return DataType::Double;
+    }
+
+    return is_unsigned(column) && is_unsigned(vt) ? DataType::UInt64 : DataType::Int64;
+}
+
+
+// the type that can hold the values of both a and b
+static DataType promote(DataType a, DataType b) {
+    if (a == b) {
+        return a;
+    }
+    if (a == DataType::Double || b == DataType::Double) {
+        return DataType::Double;
+    }
+    return DataType::Int64;
+}
+
+
+template<typename T>
+static T value_as(const Variant &v) {
+    switch (v.type()) {
+    case DataType::Int32:  return static_cast<T>(v.get<int32_t>());
+    case DataType::UInt32: return static_cast<T>(v.get<uint32_t>());
+    case DataType::Int64:  return static_cast<T>(v.get<int64_t>());
+    case DataType::UInt64: return static_cast<T>(v.get<uint64_t>());
+    case DataType::Double: return static_cast<T>(v.get<double>());
+    default:
+        throw std::invalid_argument("DataFrame::filter: unsupported data type");
+    }
+}
+
+
+// one branch-free loop per operator, so that the comparisons are vectorized
+template<typename T>
+static void compare(const T *vals, size_t n, Condition::Op op, const T &v, unsigned char *mask) {
+    switch (op) {
+    case Condition::Op::Equal:
+        for (size_t i = 0; i < n; i++) mask[i] &= vals[i] == v;
+        break;
+    case Condition::Op::NotEqual:
+        for (size_t i = 0; i < n; i++) mask[i] &= vals[i] != v;
+        break;
+    case Condition::Op::Less:
+        for (size_t i = 0; i < n; i++) mask[i] &= vals[i] < v;
+        break;
+    case Condition::Op::LessEqual:
+        for (size_t i = 0; i < n; i++) mask[i] &= vals[i] <= v;
+        break;
+    case Condition::Op::Greater:
+        for (size_t i = 0; i < n; i++) mask[i] &= vals[i] > v;
+        break;
+    case Condition::Op::GreaterEqual:
+        for (size_t i = 0; i < n; i++) mask[i] &= vals[i] >= v;
+        break;
+    }
+}
+
+
+static void scan(const base::IDataFrame &df, const std::vector<Condition> &conditions, const MaskFunction &fn) {
+    const ndsize_t total = df.rows();
+
+    // every column that is used is read once per block, as the type all its conditions need
+    std::vector<Column> columns = df.columns();
+    std::vector<std::string> names;
+    std::vector<DataType> dtypes;
+    std::vector<size_t> slot(conditions.size());
+
+    for (size_t k = 0; k < conditions.size(); k++) {
+        const Condition &c = conditions[k];
+        auto col = std::find_if(columns.cbegin(), columns.cend(),
+                                [&c](const Column &x) { return x.name == c.name; });
+        if (col == columns.cend()) {
+            throw std::invalid_argument("DataFrame::filter: unknown column " + c.name);
+        }
+
+        DataType dtype = compare_type(col->dtype, c.value);
+        auto known = std::find(names.cbegin(), names.cend(), c.name);
+        slot[k] = static_cast<size_t>(known - names.cbegin());
+        if (known == names.cend()) {
+            names.push_back(c.name);
+            dtypes.push_back(dtype);
+        } else {
+            dtypes[slot[k]] = promote(dtypes[slot[k]], dtype);
+        }
+    }
+
+    std::vector<std::vector<char>> raw(names.size());
+    std::vector<std::vector<std::string>> strings(names.size());
+    std::vector<void *> data(names.size());
+    std::vector<unsigned char> mask;
+
+    for (ndsize_t start = 0; start < total; start += filter_block) {
+        const size_t n = static_cast<size_t>(std::min(filter_block, total - start));
+
+        for (size_t i = 0; i < names.size(); i++) {
+            if (dtypes[i] == DataType::String) {
+                strings[i].resize(n);
+                data[i] = strings[i].data();
+            } else {
+                raw[i].resize(n * data_type_to_size(dtypes[i]));
+                data[i] = raw[i].data();
+            }
+        }
+        if (!names.empty()) {
+            df.readColumns(names, start, n, dtypes, data);
+        }
+
+        mask.assign(n, 1);
+        for (size_t k = 0; k < conditions.size(); k++) {
+            const Condition &c = conditions[k];
+            const size_t i = slot[k];
+
+            switch (dtypes[i]) {
+            case DataType::Bool:
+                compare(reinterpret_cast<const bool *>(data[i]), n, c.op, c.value.get<bool>(), mask.data());
+                break;
+            case DataType::Double:
+                compare(reinterpret_cast<const double *>(data[i]), n, c.op, value_as<double>(c.value), mask.data());
+                break;
+            case DataType::Int64:
+                compare(reinterpret_cast<const int64_t *>(data[i]), n, c.op, value_as<int64_t>(c.value), mask.data());
+                break;
+            case DataType::UInt64:
+                compare(reinterpret_cast<const uint64_t *>(data[i]), n, c.op, value_as<uint64_t>(c.value), mask.data());
+                break;
+            case DataType::String:
+                compare(strings[i].data(), n, c.op, c.value.get<std::string>(), mask.data());
+                break;
+            default:
+                break;
+            }
+        }
+
+        fn(start, mask.data(), n);
+    }
+}
+
+
+std::vector<ndsize_t> DataFrame::filter(const std::vector<Condition> &conditions) const {
+    std::vector<ndsize_t> rows;
+    scan(*backend(), conditions, [&rows](ndsize_t start, const unsigned char *mask, size_t n) {
+        for (size_t i = 0; i < n; i++) {
+            if (mask[i]) {
+                rows.push_back(start + i);
+            }
+        }
+    });
+    return rows;
+}
+
+
+std::vector<bool> DataFrame::filterMask(const std::vector<Condition> &conditions) const {
+    std::vector<bool> selected;
+    scan(*backend(), conditions, [&selected](ndsize_t, const unsigned char *mask, size_t n) {
+        selected.insert(selected.end(), mask, mask + n);
+    });
+    return selected;
+}
+
+
+std::vector<ndsize_t> DataFrame::lookup(const std::string &name, const Variant &lower, const Variant &upper) const {
+    std::vector<Column> columns = this->columns();
+    auto col = std::find_if(columns.cbegin(), columns.cend(),
+                            [&name](const Column &x) { return x.name == name; });
+    if (col == columns.cend()) {
+        throw std::invalid_argument("DataFrame::lookup: unknown column " + name);
+    }
+
+    const DataType dtype = promote(compare_type(col->dtype, lower), compare_type(col->dtype, upper));
+    std::vector<ndsize_t> rows;
+    bool found = false;
+
+    switch (dtype) {
+    case DataType::Double: {
+        const double lo = value_as<double>(lower), hi = value_as<double>(upper);
+        found = backend()->lookup(name, dtype, &lo, &hi, rows);
+        break;
+    }
+    case DataType::Int64: {
+        const int64_t lo = value_as<int64_t>(lower), hi = value_as<int64_t>(upper);
+        found = backend()->lookup(name, dtype, &lo, &hi, rows);
+        break;
+    }
+    case DataType::UInt64: {
+        const uint64_t lo = value_as<uint64_t>(lower), hi = value_as<uint64_t>(upper);
+        found = backend()->lookup(name, dtype, &lo, &hi, rows);
+        break;
+    }
+    case DataType::String: {
+        const std::string lo = lower.get<std::string>(), hi = upper.get<std::string>();
+        found = backend()->lookup(name, dtype, &lo, &hi, rows);
+        break;
+    }
+    default:
+        break;
+    }
+
+    if (found) {
+        return rows;
+    }
+    return filter({{name, Condition::Op::GreaterEqual, lower}, {name, Condition::Op::LessEqual, upper}});
+}
+
+}
@@ -0,0 +1,86 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/DataSpan.hpp>
+
+#include <cstring>
+#include <stdexcept>
+
+namespace nix {
+
+DataSpan::DataSpan(DataType dtype, void *data, NDSize shape, NDSize strides)
+    : dtype(dtype), ptr(data), dims(std::move(shape)), steps(std::move(strides)) {
+
+    if (dtype == DataType::String || dtype == DataType::Nothing) {
+        throw std::invalid_argument("DataSpan: strings are not supported");
+    }
+
+    if (!steps) {
+        steps = NDSize(dims.size(), 1);
+        for (size_t d = dims.size(); d > 1; --d) {
+            steps[d - 2] = steps[d - 1] * dims[d - 1];
+        }
+    } else if (steps.size() != dims.size()) {
+        throw IncompatibleDimensions("DataSpan: strides and shape must have the same dimensionality", "DataSpan");
+    }
+}
+
+
+bool DataSpan::contiguous() const {
+    ndsize_t expected = 1;
+    for (size_t d = dims.size(); d > 0; --d) {
+        if (dims[d - 1] > 1 && steps[d - 1] != expected) {
+            return false;
+        }
+        expected *= dims[d - 1];
+    }
+    return true;
+}
+
+
+bool DataSpan::nested() const {
+    for (size_t d = 0; d < dims.size(); ++d) {
+        if (steps[d] == 0) {
+            return false;
+        }
+        if (d > 0 && (steps[d - 1] % steps[d] != 0 || (dims[d] - 1) * steps[d] >= steps[d - 1])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+
+void DataSpan::scatter(const void *source) const {
+    const size_t rank = dims.size();
+    const ndsize_t nelms = dims.nelms();
+    if (nelms == 0) {
+        return;
+    }
+
+    const size_t esize = data_type_to_size(dtype);
+    const char *src = static_cast<const char *>(source);
+    char *dst = static_cast<char *>(ptr);
+
+    // walk the elements in row-major order, index holds the position in the span
+    NDSize index(rank, 0);
+    ndsize_t target = 0;
+    for (ndsize_t i = 0; i < nelms; ++i) {
+        memcpy(dst + target * esize, src + i * esize, esize);
+        for (size_t d = rank; d > 0; --d) {
+            if (++index[d - 1] < dims[d - 1]) {
+                target += steps[d - 1];
+                break;
+            }
+            target -= (index[d - 1] - 1) * steps[d - 1];
+            index[d - 1] = 0;
+        }
+    }
+}
+
+} // namespace nix
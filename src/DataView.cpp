@@ -12,6 +12,10 @@
 #include <nix/DataView.hpp>
 
 #include <nix/Exception.hpp>
+#include <nix/util/util.hpp>
+
+#include <algorithm>
+#include <limits>
 
 namespace nix {
 
@@ -56,8 +60,170 @@ void DataView::ioWrite(DataType dtype, const void *data, const NDSize &count, co
     array.setData(dtype, data, real_count, base);
 }
 
+void DataView::ioReadStrided(const DataSpan &span, const NDSize &offset) const {
+    NDSize base = transform_coordinates(span.shape(), offset);
+    array.getData(span, base);
+}
+
 DataType DataView::dataType() const {
     return array.dataType();
 }
 
-}
\ No newline at end of file
+CalibratedView::CalibratedView(DataArray da, NDSize count, NDSize offset)
+    : DataView(std::move(da), std::move(count), std::move(offset)),
+      coefficients(array.polynomCoefficients()), origin(0.0) {
+
+    if (!data_type_is_numeric(array.dataType())) {
+        throw std::invalid_argument("CalibratedView: the data of the DataArray must be numeric");
+    }
+    boost::optional<double> expansion_origin = array.expansionOrigin();
+    if (expansion_origin) {
+        origin = *expansion_origin;
+    }
+}
+
+CalibratedView::CalibratedView(const DataArray &da)
+    : CalibratedView(da, da.dataExtent(), NDSize(da.dataExtent().size(), 0)) {
+}
+
+void CalibratedView::getRawData(DataType dtype, void *data, const NDSize &count, const NDSize &offset) const {
+    const NDSize &real_count =  count ? count : this->count;
+    NDSize base = transform_coordinates(real_count, offset);
+    array.getDataDirect(dtype, data, real_count, base);
+}
+
+double CalibratedView::calibrate(double raw) const {
+    double value;
+    util::applyPolynomial(coefficients, origin, &raw, &value, 1);
+    return value;
+}
+
+void CalibratedView::forEachRawBlock(const std::function<void(const void *, DataType, size_t, const NDSize &, const NDSize &)> &fn,
+                                     ndsize_t max_elements) const {
+    if (count.size() == 0 || count.nelms() == 0) {
+        return;
+    }
+
+    ndsize_t slice = count.nelms() / count[0];
+    ndsize_t rows = std::max<ndsize_t>(1, max_elements / slice);
+    DataType stored = array.dataType();
+    std::vector<char> raw;
+
+    for (ndsize_t start = 0; start < count[0]; start += rows) {
+        NDSize block_count = count;
+        block_count[0] = std::min(rows, count[0] - start);
+        NDSize block_offset(count.size(), 0);
+        block_offset[0] = start;
+
+        size_t n = check::fits_in_size_t(block_count.nelms(), "CalibratedView: block exceeds memory");
+        raw.resize(n * data_type_to_size(stored));
+        array.getDataDirect(stored, raw.data(), block_count, offset + block_offset);
+        fn(raw.data(), stored, n, block_count, block_offset);
+    }
+}
+
+void CalibratedView::forEachBlock(const BlockFunction &fn, ndsize_t max_elements) const {
+    std::vector<double> values;
+    forEachRawBlock([&](const void *raw, DataType type, size_t n, const NDSize &c, const NDSize &o) {
+        values.resize(n);
+        util::applyPolynomial(coefficients, origin, type, raw, DataType::Double, values.data(), n);
+        fn(values.data(), c, o);
+    }, max_elements);
+}
+
+typedef void (*ExtremesFunction)(const void *raw, size_t n, double &lo, double &hi);
+
+// the extremes of raw values compared in their stored type, NaN are ignored
+template<typename T>
+static void raw_extremes(const void *raw, size_t n, double &lo, double &hi) {
+    const T *values = static_cast<const T *>(raw);
+    size_t i = 0;
+    while (i < n && values[i] != values[i]) {
+        ++i;
+    }
+    if (i == n) {
+        return;
+    }
+
+    T min = values[i], max = values[i];
+    for (; i < n; ++i) {
+        min = values[i] < min ? values[i] : min;
+        max = values[i] > max ? values[i] : max;
+    }
+    lo = std::min(lo, static_cast<double>(min));
+    hi = std::max(hi, static_cast<double>(max));
+}
+
+static ExtremesFunction raw_extremes_for(DataType type) {
+    switch (type) {
+    case DataType::Int8:   return raw_extremes<int8_t>;
+    case DataType::Int16:  return raw_extremes<int16_t>;
+    case DataType::Int32:  return raw_extremes<int32_t>;
+    case DataType::Int64:  return raw_extremes<int64_t>;
+    case DataType::UInt8:  return raw_extremes<uint8_t>;
+    case DataType::UInt16: return raw_extremes<uint16_t>;
+    case DataType::UInt32: return raw_extremes<uint32_t>;
+    case DataType::UInt64: return raw_extremes<uint64_t>;
+    case DataType::Float:  return raw_extremes<float>;
+    case DataType::Double: return raw_extremes<double>;
+    default:               return nullptr;
+    }
+}
+
+std::pair<double, double> CalibratedView::range() const {
+    double lo = std::numeric_limits<double>::infinity();
+    double hi = -lo;
+
+    // a linear calibration is monotonic, only its value at the raw extremes is
+    // needed, and those are found without converting the raw values
+    ExtremesFunction extremes = coefficients.size() <= 2 ? raw_extremes_for(array.dataType()) : nullptr;
+    if (extremes) {
+        forEachRawBlock([&](const void *raw, DataType, size_t n, const NDSize &, const NDSize &) {
+            extremes(raw, n, lo, hi);
+        }, 65536);
+    } else {
+        forEachBlock([&](const double *values, const NDSize &c, const NDSize &) {
+            const size_t n = static_cast<size_t>(c.nelms());
+            for (size_t i = 0; i < n; ++i) {
+                lo = values[i] < lo ? values[i] : lo;
+                hi = values[i] > hi ? values[i] : hi;
+            }
+        });
+    }
+
+    if (lo > hi) {
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        return std::make_pair(nan, nan);
+    }
+    if (extremes) {
+        lo = calibrate(lo);
+        hi = calibrate(hi);
+        return std::make_pair(std::min(lo, hi), std::max(lo, hi));
+    }
+    return std::make_pair(lo, hi);
+}
+
+std::vector<ndsize_t> CalibratedView::crossings(double threshold, bool rising) const {
+    if (count.size() != 1) {
+        throw IncompatibleDimensions("Threshold crossings need a one-dimensional view", "CalibratedView::crossings");
+    }
+
+    std::vector<ndsize_t> found;
+    bool first = true;
+    double previous = 0.0;
+    forEachBlock([&](const double *values, const NDSize &c, const NDSize &o) {
+        for (size_t i = 0; i < c[0]; ++i) {
+            const double value = values[i];
+            bool crossed = rising ? previous < threshold && value >= threshold :
+                                    previous > threshold && value <= threshold;
+            if (crossed && !first) {
+                found.push_back(o[0] + i);
+            }
+            previous = value;
+            first = false;
+        }
+    });
+    return found;
+}
+
+}
@@ -278,18 +278,58 @@ boost::optional<std::pair<ndsize_t, ndsize_t>> SampledDimension::indexOf(double
 }
 
 
-std::vector<boost::optional<std::pair<ndsize_t, ndsize_t>>> SampledDimension::indexOf(const std::vector<double> &start_positions,
-                                                                                      const std::vector<double> &end_positions,
-                                                                                      const RangeMatch range_matching) const {
+// Same as SampledDimension::indexOf(start, end, sampling_interval, offset, match) for
+// count ranges at once. The loop body is kept free of branches and of optionals
+// so that the compiler can vectorize it.
+static void getSampledRanges(const double *starts, const double *ends, size_t count,
+                             const double offset, const double sampling_interval, const RangeMatch match,
+                             ndsize_t *start_indices, ndsize_t *end_indices, char *valid) {
+    const bool exclusive = match == RangeMatch::Exclusive;
+    const double eps = numeric_limits<double>::epsilon();
+    for (size_t i = 0; i < count; ++i) {
+        double si = ceil((starts[i] - offset) / sampling_interval);
+        si = si < 0.0 ? 0.0 : si;
+        double ei = floor((ends[i] - offset) / sampling_interval);
+        bool on_tick = fabs(ei * sampling_interval + offset - ends[i]) <= eps;
+        ei = (exclusive && on_tick) ? ei - 1.0 : ei;
+
+        valid[i] = starts[i] <= ends[i] && ends[i] >= offset && ei >= 0.0 && si <= ei;
+        start_indices[i] = static_cast<ndsize_t>(si);
+        end_indices[i] = static_cast<ndsize_t>(ei < 0.0 ? 0.0 : ei);
+    }
+}
+
+
+void SampledDimension::indexOf(const std::vector<double> &start_positions, const std::vector<double> &end_positions,
+                               const RangeMatch match, std::vector<ndsize_t> &start_indices,
+                               std::vector<ndsize_t> &end_indices, std::vector<char> &valid) const {
     if (start_positions.size() != end_positions.size()) {
         throw runtime_error("Dimension::IndexOf - Number of start and end positions must match!");
     }
 
-    std::vector<boost::optional<std::pair<ndsize_t, ndsize_t>>> indices;
+    size_t count = start_positions.size();
+    start_indices.resize(count);
+    end_indices.resize(count);
+    valid.resize(count);
     double offset = backend()->offset() ? *(backend()->offset()) : 0.0;
     double sampling_interval = backend()->samplingInterval();
-    for (size_t i = 0; i < start_positions.size(); ++i) {
-        indices.push_back(indexOf(start_positions[i], end_positions[i], sampling_interval, offset, range_matching));
+    getSampledRanges(start_positions.data(), end_positions.data(), count, offset, sampling_interval, match,
+                     start_indices.data(), end_indices.data(), valid.data());
+}
+
+
+std::vector<boost::optional<std::pair<ndsize_t, ndsize_t>>> SampledDimension::indexOf(const std::vector<double> &start_positions,
+                                                                                      const std::vector<double> &end_positions,
+                                                                                      const RangeMatch range_matching) const {
+    std::vector<ndsize_t> start_indices, end_indices;
+    std::vector<char> valid;
+    indexOf(start_positions, end_positions, range_matching, start_indices, end_indices, valid);
+
+    std::vector<boost::optional<std::pair<ndsize_t, ndsize_t>>> indices(valid.size());
+    for (size_t i = 0; i < valid.size(); ++i) {
+        if (valid[i]) {
+            indices[i] = std::make_pair(start_indices[i], end_indices[i]);
+        }
     }
     return indices;
 }
@@ -300,16 +340,16 @@ std::vector<std::pair<ndsize_t, ndsize_t>> SampledDimension::indexOf(const std::
         throw runtime_error("Dimension::IndexOf - Number of start and end positions must match!");
     }
 
-    std::vector<std::pair<ndsize_t, ndsize_t>> indices;
-    double offset = backend()->offset() ? *(backend()->offset()) : 0.0;
-    double sampling_interval = backend()->samplingInterval();
-    boost::optional<std::pair<ndsize_t, ndsize_t>> pair;
-    for (size_t i = 0; i < start_positions.size(); ++i) {
-        pair = indexOf(start_positions[i], end_positions[i], sampling_interval, offset, RangeMatch::Inclusive);
-        if (!pair) {
+    std::vector<ndsize_t> start_indices, end_indices;
+    std::vector<char> valid;
+    indexOf(start_positions, end_positions, RangeMatch::Inclusive, start_indices, end_indices, valid);
+
+    std::vector<std::pair<ndsize_t, ndsize_t>> indices(valid.size());
+    for (size_t i = 0; i < valid.size(); ++i) {
+        if (!valid[i]) {
             throw nix::OutOfBounds("SampledDimension::indexOf: an invalid range was encountered");
         }
-        indices.push_back(*pair);
+        indices[i] = std::make_pair(start_indices[i], end_indices[i]);
     }
     return indices;
 }
@@ -572,14 +612,53 @@ double RangeDimension::tickAt(const ndsize_t index) const {
 }
 
 
+namespace {
+
+// Random access to the ticks of a RangeDimension: either a vector in memory
+// or, if the backend does not keep the ticks in memory, the backend itself
+class TickAccess {
+public:
+    explicit TickAccess(const IRangeDimension *dim)
+        : dim(dim), cached(dim->cachedTicks()), ticks(cached.get()),
+          count(ticks ? ticks->size() : dim->tickCount()) {}
+
+    explicit TickAccess(const vector<double> &ticks)
+        : ticks(&ticks), count(ticks.size()) {}
+
+    ndsize_t size() const {
+        return count;
+    }
+
+    double operator[](ndsize_t index) const {
+        return ticks ? (*ticks)[index] : dim->ticks(index, 1)[0];
+    }
+
+    // index of the first tick not less than position
+    ndsize_t lowerBound(double position) const {
+        if (ticks) {
+            return std::lower_bound(ticks->begin(), ticks->end(), position) - ticks->begin();
+        }
+        return dim->lowerBound(position);
+    }
+
+private:
+    const IRangeDimension *dim = nullptr;
+    shared_ptr<const vector<double>> cached;
+    const vector<double> *ticks;
+    ndsize_t count;
+};
+
+}
+
+
 PositionInRange RangeDimension::positionInRange(const double position) const {
     PositionInRange result;
-    vector<double> ticks = this->ticks();
+    TickAccess ticks(backend());
     if (ticks.size() == 0) {
         result = PositionInRange::NoRange;
-    } else if (position < *ticks.begin()) {
+    } else if (position < ticks[0]) {
         result = PositionInRange::Less;
-    } else if (position > *prev(ticks.end())) {
+    } else if (position > ticks[ticks.size() - 1]) {
         result = PositionInRange::Greater;
     } else {
         result = PositionInRange::InRange;
@@ -588,46 +667,48 @@ PositionInRange RangeDimension::positionInRange(const double position) const {
 }
 
 
-boost::optional<ndsize_t> getIndex(const double position, std::vector<double> &ticks, PositionMatch matching) {
+static boost::optional<ndsize_t> getIndex(const double position, const TickAccess &ticks, PositionMatch matching) {
     boost::optional<ndsize_t> idx;
+    ndsize_t count = ticks.size();
     // check easy cases first ...
-    if (ticks.size() == 0)
+    if (count == 0)
         return idx;
-    if (position < *ticks.begin()) {
+    if (position < ticks[0]) {
         if (matching == PositionMatch::Greater || matching == PositionMatch::GreaterOrEqual)
             idx = 0;
         return idx;
-    } else if (position > *prev(ticks.end())) {
+    } else if (position > ticks[count - 1]) {
         if (matching == PositionMatch::Less || matching == PositionMatch::LessOrEqual)
-            idx =  prev(ticks.end()) - ticks.begin();
+            idx = count - 1;
         return idx;
     }
     // need to do some searching --> first element larger or equal to position
-    std::vector<double>::iterator lower = std::lower_bound(ticks.begin(), ticks.end(), position);
+    ndsize_t lower = ticks.lowerBound(position);
+    double lower_tick = ticks[lower];
     if (matching == PositionMatch::Greater || matching == PositionMatch::GreaterOrEqual) {
-        idx = lower - ticks.begin();
-        if (matching == PositionMatch::Greater && *lower == position) {
-            if ((lower + 1) < ticks.end()) {
-                idx = lower + 1 - ticks.begin();
+        idx = lower;
+        if (matching == PositionMatch::Greater && lower_tick == position) {
+            if ((lower + 1) < count) {
+                idx = lower + 1;
             } else {
                 idx = boost::none;
             }
         }
-    } else if (matching == PositionMatch::LessOrEqual && *lower > position) {
-        if (lower - 1 >= ticks.begin()) {
-            idx = lower - 1 - ticks.begin();
+    } else if (matching == PositionMatch::LessOrEqual && lower_tick > position) {
+        if (lower > 0) {
+            idx = lower - 1;
         } else {
             idx = boost::none;
         }
-    } else if (matching == PositionMatch::Less && *lower >= position) {
-        if ((lower - 1) >= ticks.begin()) {
-            idx = lower - 1 - ticks.begin();
+    } else if (matching == PositionMatch::Less && lower_tick >= position) {
+        if (lower > 0) {
+            idx = lower - 1;
         } else {
             idx = boost::none;
         }
     } else { // exact match
-        if (lower != ticks.end() && *lower == position) {
-            idx = lower - ticks.begin();
+        if (lower_tick == position) {
+            idx = lower;
         }
     }
     return idx;
@@ -635,18 +716,25 @@ boost::optional<ndsize_t> getIndex(const double position, std::vector<double> &t
 
 
 boost::optional<ndsize_t> RangeDimension::indexOf(const double position, PositionMatch matching) const {
-    vector<double> ticks = this->ticks();
-    boost::optional<ndsize_t> index = getIndex(position, ticks, matching);
+    boost::optional<ndsize_t> index = getIndex(position, TickAccess(backend()), matching);
     return index;
 }
 
 
-boost::optional<std::pair<ndsize_t, ndsize_t>> RangeDimension::indexOf(double start, double end,
-                                                                       std::vector<double> ticks,
-                                                                       RangeMatch match) const {
-    if (ticks.size() == 0) {
-        ticks = this->ticks();
+std::vector<boost::optional<ndsize_t>> RangeDimension::indexOf(const std::vector<double> &positions,
+                                                               PositionMatch matching) const {
+    TickAccess ticks(backend());
+    std::vector<boost::optional<ndsize_t>> indices;
+    indices.reserve(positions.size());
+    for (double position : positions) {
+        indices.push_back(getIndex(position, ticks, matching));
     }
+    return indices;
+}
+
+
+static boost::optional<std::pair<ndsize_t, ndsize_t>> getRange(double start, double end, const TickAccess &ticks,
+                                                               RangeMatch match) {
     boost::optional<std::pair<ndsize_t, ndsize_t>> range;
     if (start > end){
         return range;
@@ -665,10 +753,19 @@ boost::optional<std::pair<ndsize_t, ndsize_t>> RangeDimension::indexOf(double st
 }
 
 
+boost::optional<std::pair<ndsize_t, ndsize_t>> RangeDimension::indexOf(double start, double end,
+                                                                       std::vector<double> ticks,
+                                                                       RangeMatch match) const {
+    if (ticks.size() == 0) {
+        return getRange(start, end, TickAccess(backend()), match);
+    }
+    return getRange(start, end, TickAccess(ticks), match);
+}
+
+
 ndsize_t RangeDimension::indexOf(const double position, bool less_or_equal) const {
-    vector<double> ticks = this->ticks();
     PositionMatch matching = less_or_equal ? PositionMatch::LessOrEqual : PositionMatch::GreaterOrEqual;
-    boost::optional<ndsize_t> index = getIndex(position, ticks, matching);
+    boost::optional<ndsize_t> index = getIndex(position, TickAccess(backend()), matching);
     if (index)
         return *index;
     else
@@ -677,7 +774,7 @@ ndsize_t RangeDimension::indexOf(const double position, bool less_or_equal) cons
 
 
 pair<ndsize_t, ndsize_t> RangeDimension::indexOf(const double start, const double end) const {
-    vector<double> ticks = this->ticks();
+    TickAccess ticks(backend());
     boost::optional<ndsize_t> si = getIndex(start, ticks, PositionMatch::GreaterOrEqual);
     boost::optional<ndsize_t> ei = getIndex(end, ticks, PositionMatch::LessOrEqual);
     if (!ei || !si) {
@@ -712,11 +809,10 @@ std::vector<boost::optional<std::pair<ndsize_t, ndsize_t>>> RangeDimension::inde
     }
 
     std::vector<boost::optional<std::pair<ndsize_t, ndsize_t>>> indices;
-    vector<double> ticks = this->ticks();
+    indices.reserve(start_positions.size());
+    TickAccess ticks(backend());
     for (size_t i = 0; i < start_positions.size(); ++i) {
-        boost::optional<std::pair<ndsize_t, ndsize_t>> range;
-        range = this->indexOf(start_positions[i], end_positions[i], ticks, match);
-        indices.push_back(range);
+        indices.push_back(getRange(start_positions[i], end_positions[i], ticks, match));
     }
     return indices;
 }
@@ -873,6 +969,20 @@ std::vector<boost::optional<std::pair<ndsize_t, ndsize_t>>> DataFrameDimension::
 }
 
 
+std::vector<ndsize_t> DataFrameDimension::lookup(const Variant &lower, const Variant &upper, boost::optional<unsigned> col_index) const {
+    boost::optional<unsigned> column_index = col_index ? col_index : columnIndex();
+    if (!column_index) {
+        throw nix::OutOfBounds("DataFrameDimension: Error accessing column, no column index was given and no default is specified.");
+    }
+    nix::DataFrame df = data();
+    std::vector<Column> cols = df.columns();
+    if (static_cast<size_t>(*column_index) >= cols.size()) {
+        throw nix::OutOfBounds("DataFrameDimension: Error accessing column, column index exceeds number of columns!");
+    }
+    return df.lookup(cols[*column_index].name, lower, upper);
+}
+
+
 DataFrameDimension& DataFrameDimension::operator=(const DataFrameDimension &other) {
     shared_ptr<IDataFrameDimension> tmp(other.impl());
 
@@ -25,15 +25,13 @@ File File::open(const std::string &name,
                 FileMode mode,
                 const std::string &impl,
                 Compression compression,
-                OpenFlags flags) {
+                OpenFlags flags,
+                const ChunkCache &cache) {
     if (mode == nix::FileMode::ReadOnly && !bfs::exists(bfs::path{name})) {
         throw std::runtime_error("Cannot open non-existent file in ReadOnly mode!");
     }
-    if (compression == Compression::Auto) {
-         compression = Compression::None;
-    }
     if (impl == "hdf5") {
-        return File(std::make_shared<hdf5::FileHDF5>(name, mode, compression, flags));
+        return File(std::make_shared<hdf5::FileHDF5>(name, mode, compression, flags, cache));
     }
 #ifdef  ENABLE_FS_BACKEND
     else if (impl == "file") {
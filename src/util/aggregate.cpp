@@ -0,0 +1,231 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/util/aggregate.hpp>
+
+#include <nix/util/dataAccess.hpp>
+#include <nix/util/util.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <limits>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+
+using namespace std;
+
+namespace nix {
+namespace util {
+
+
+void Statistics::grow(size_t size) {
+    if (size <= n.size()) {
+        return;
+    }
+    n.resize(size, 0);
+    means.resize(size, 0.0);
+    m2.resize(size, 0.0);
+    mins.resize(size, numeric_limits<double>::infinity());
+    maxs.resize(size, -numeric_limits<double>::infinity());
+}
+
+
+void Statistics::add(const double *values, size_t count) {
+    grow(count);
+    for (size_t i = 0; i < count; ++i) {
+        const double x = values[i];
+        n[i] += 1;
+        const double delta = x - means[i];
+        means[i] += delta / static_cast<double>(n[i]);
+        m2[i] += delta * (x - means[i]);
+        mins[i] = std::min(mins[i], x);
+        maxs[i] = std::max(maxs[i], x);
+    }
+}
+
+
+void Statistics::merge(const Reducer &other) {
+    const Statistics *stats = dynamic_cast<const Statistics *>(&other);
+    if (stats == nullptr) {
+        throw invalid_argument("Statistics::merge: can only merge with other Statistics");
+    }
+
+    grow(stats->n.size());
+    for (size_t i = 0; i < stats->n.size(); ++i) {
+        if (stats->n[i] == 0) {
+            continue;
+        }
+        // combine the two partial results (Chan et al.)
+        const double na = static_cast<double>(n[i]);
+        const double nb = static_cast<double>(stats->n[i]);
+        const double total = na + nb;
+        const double delta = stats->means[i] - means[i];
+        means[i] += delta * nb / total;
+        m2[i] += stats->m2[i] + delta * delta * na * nb / total;
+        n[i] += stats->n[i];
+        mins[i] = std::min(mins[i], stats->mins[i]);
+        maxs[i] = std::max(maxs[i], stats->maxs[i]);
+    }
+}
+
+
+unique_ptr<Reducer> Statistics::empty() const {
+    return unique_ptr<Reducer>(new Statistics());
+}
+
+
+vector<double> Statistics::sum() const {
+    vector<double> sums(n.size());
+    for (size_t i = 0; i < n.size(); ++i) {
+        sums[i] = means[i] * static_cast<double>(n[i]);
+    }
+    return sums;
+}
+
+
+vector<double> Statistics::variance() const {
+    vector<double> var(n.size(), numeric_limits<double>::quiet_NaN());
+    for (size_t i = 0; i < n.size(); ++i) {
+        if (n[i] > 1) {
+            var[i] = m2[i] / static_cast<double>(n[i] - 1);
+        }
+    }
+    return var;
+}
+
+
+Histogram::Histogram(vector<double> edges)
+    : bin_edges(std::move(edges)), outside_count(0) {
+
+    if (bin_edges.size() < 2 || !std::is_sorted(bin_edges.begin(), bin_edges.end()) ||
+        std::adjacent_find(bin_edges.begin(), bin_edges.end()) != bin_edges.end()) {
+        throw invalid_argument("Histogram: at least two strictly increasing edges are needed");
+    }
+    bin_counts.resize(bin_edges.size() - 1, 0);
+}
+
+
+void Histogram::add(const double *values, size_t count) {
+    const size_t nbins = bin_counts.size();
+    for (size_t i = 0; i < count; ++i) {
+        const double x = values[i];
+        // written such that NaN ends up outside as well
+        if (!(x >= bin_edges.front() && x <= bin_edges.back())) {
+            outside_count++;
+            continue;
+        }
+        size_t bin = static_cast<size_t>(std::upper_bound(bin_edges.begin(), bin_edges.end(), x) - bin_edges.begin()) - 1;
+        bin_counts[std::min(bin, nbins - 1)]++;
+    }
+}
+
+
+void Histogram::merge(const Reducer &other) {
+    const Histogram *hist = dynamic_cast<const Histogram *>(&other);
+    if (hist == nullptr || hist->bin_edges != bin_edges) {
+        throw invalid_argument("Histogram::merge: can only merge with a Histogram with the same edges");
+    }
+    for (size_t i = 0; i < bin_counts.size(); ++i) {
+        bin_counts[i] += hist->bin_counts[i];
+    }
+    outside_count += hist->outside_count;
+}
+
+
+unique_ptr<Reducer> Histogram::empty() const {
+    return unique_ptr<Reducer>(new Histogram(bin_edges));
+}
+
+
+void aggregateTaggedData(const MultiTag &tag, const DataArray &array, Reducer &reducer,
+                         vector<ndsize_t> position_indices, RangeMatch match, size_t threads) {
+    if (position_indices.empty()) {
+        size_t pos_count = check::fits_in_size_t(tag.positions().dataExtent()[0],
+                                                 "Number of positions > size_t.");
+        position_indices.resize(pos_count);
+        std::iota(position_indices.begin(), position_indices.end(), 0);
+    }
+    if (position_indices.empty()) {
+        return;
+    }
+
+    vector<NDSize> offsets, counts;
+    getOffsetAndCount(tag, array, position_indices, offsets, counts, match);
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        if (!positionAndExtentInData(array, offsets[i], counts[i])) {
+            throw OutOfBounds("References data slice out of the extent of the DataArray!", 0);
+        }
+    }
+
+    // visit the windows in the order they are stored
+    const size_t count = offsets.size();
+    vector<size_t> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&offsets](size_t a, size_t b) {
+        return std::lexicographical_compare(offsets[a].begin(), offsets[a].end(),
+                                            offsets[b].begin(), offsets[b].end());
+    });
+
+    if (threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads = std::min(threads, count);
+
+    mutex io_mutex;
+    atomic<size_t> next(0);
+    auto work = [&](Reducer &target) {
+        vector<double> window;
+        for (size_t k = next++; k < count; k = next++) {
+            size_t i = order[k];
+            window.resize(check::fits_in_size_t(counts[i].nelms(), "Window exceeds memory."));
+            {
+                // the HDF5 library is not necessarily thread-safe
+                lock_guard<mutex> lock(io_mutex);
+                array.getData(DataType::Double, window.data(), counts[i], offsets[i]);
+            }
+            target.add(window.data(), window.size());
+        }
+    };
+
+    if (threads < 2) {
+        work(reducer);
+        return;
+    }
+
+    vector<unique_ptr<Reducer>> partial(threads);
+    vector<exception_ptr> errors(threads);
+    vector<thread> workers;
+    for (size_t t = 0; t < threads; ++t) {
+        partial[t] = reducer.empty();
+        workers.emplace_back([&, t]() {
+            try {
+                work(*partial[t]);
+            } catch (...) {
+                errors[t] = current_exception();
+                next = count;
+            }
+        });
+    }
+    for (thread &worker : workers) {
+        worker.join();
+    }
+    for (const exception_ptr &error : errors) {
+        if (error) {
+            rethrow_exception(error);
+        }
+    }
+    for (const unique_ptr<Reducer> &p : partial) {
+        reducer.merge(*p);
+    }
+}
+
+} // namespace util
+} // namespace nix
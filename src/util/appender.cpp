@@ -0,0 +1,232 @@
+// Copyright (c) 2013, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include <nix/util/appender.hpp>
+
+#include <nix/Exception.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+using namespace std;
+
+namespace nix {
+namespace util {
+
+// wake-ups are sent without holding the mutex, so waits are bounded to not miss one
+static const chrono::milliseconds max_wait(10);
+
+
+DataArrayAppender::DataArrayAppender(const DataArray &array, DataType dtype, size_t axis,
+                                     size_t flush_rows, size_t capacity, size_t threads)
+    : array(array), dtype(dtype), axis(axis), outer(1), inner_bytes(data_type_to_size(dtype)),
+      flush_rows(flush_rows), slots(capacity), threads(threads),
+      head(0), tail(0), flush_target(0), stopping(false), failed(false) {
+
+    if (dtype == DataType::String) {
+        throw invalid_argument("DataArrayAppender: strings can not be appended");
+    }
+    NDSize extent = array.dataExtent();
+    if (axis >= extent.size()) {
+        throw InvalidRank("axis is out of bounds");
+    }
+
+    row_shape = extent;
+    row_shape[axis] = 1;
+    for (size_t d = 0; d < extent.size(); ++d) {
+        size_t n = check::fits_in_size_t(extent[d], "DataArrayAppender: extent exceeds memory");
+        if (d < axis) {
+            outer *= n;
+        } else if (d > axis) {
+            inner_bytes *= n;
+        }
+    }
+
+    if (this->flush_rows == 0) {
+        NDSize chunks = array.chunking();
+        this->flush_rows = chunks.size() == extent.size() ? static_cast<size_t>(chunks[axis]) : 1024;
+    }
+    this->flush_rows = std::max<size_t>(1, this->flush_rows);
+    if (slots == 0) {
+        slots = 8 * this->flush_rows;
+    }
+    slots = std::max(slots, this->flush_rows);
+
+    ring.resize(slots * outer * inner_bytes);
+    writer = thread(&DataArrayAppender::run, this);
+}
+
+
+DataArrayAppender::~DataArrayAppender() {
+    try {
+        stop();
+    } catch (...) {
+        // nowhere to report it
+    }
+}
+
+
+bool DataArrayAppender::tryAppend(const void *data, size_t rows) {
+    checkError();
+    if (stopping) {
+        throw runtime_error("DataArrayAppender: appender has been closed");
+    }
+
+    const size_t h = head.load(memory_order_relaxed);
+    const size_t t = tail.load(memory_order_acquire);
+    if (slots - (h - t) < rows) {
+        return false;
+    }
+    if (rows == 0) {
+        return true;
+    }
+
+    const size_t row_bytes = outer * inner_bytes;
+    const char *src = static_cast<const char *>(data);
+    if (outer == 1) {
+        // the rows are contiguous, at most two copies around the end of the ring
+        size_t first = (h % slots);
+        size_t n = std::min(rows, slots - first);
+        memcpy(ring.data() + first * row_bytes, src, n * row_bytes);
+        memcpy(ring.data(), src + n * row_bytes, (rows - n) * row_bytes);
+    } else {
+        for (size_t j = 0; j < rows; ++j) {
+            char *slot = ring.data() + ((h + j) % slots) * row_bytes;
+            for (size_t a = 0; a < outer; ++a) {
+                memcpy(slot + a * inner_bytes, src + (a * rows + j) * inner_bytes, inner_bytes);
+            }
+        }
+    }
+
+    head.store(h + rows, memory_order_release);
+    if (h + rows - t >= flush_rows) {
+        data_ready.notify_one();
+    }
+    return true;
+}
+
+
+void DataArrayAppender::append(const void *data, size_t rows) {
+    if (rows <= slots) {
+        while (!tryAppend(data, rows)) {
+            // the space may be held by less than flush_rows rows, have them written as well
+            flush_target.store(head.load());
+            data_ready.notify_one();
+            unique_lock<mutex> lock(wait_mutex);
+            space_ready.wait_for(lock, max_wait);
+        }
+        return;
+    }
+
+    // more rows than fit into the buffer: hand them over in pieces
+    const char *src = static_cast<const char *>(data);
+    vector<char> piece;
+    for (size_t start = 0; start < rows; start += slots) {
+        size_t n = std::min(slots, rows - start);
+        const void *block = src + start * inner_bytes;
+        if (outer > 1) {
+            piece.resize(n * outer * inner_bytes);
+            for (size_t a = 0; a < outer; ++a) {
+                memcpy(piece.data() + a * n * inner_bytes, src + (a * rows + start) * inner_bytes, n * inner_bytes);
+            }
+            block = piece.data();
+        }
+        append(block, n);
+    }
+}
+
+
+void DataArrayAppender::flush() {
+    checkError();
+    const size_t target = head.load();
+    flush_target.store(target);
+    data_ready.notify_one();
+
+    unique_lock<mutex> lock(wait_mutex);
+    while (tail.load() < target && !failed && writer.joinable()) {
+        space_ready.wait_for(lock, max_wait);
+    }
+    lock.unlock();
+    checkError();
+}
+
+
+void DataArrayAppender::close() {
+    stop();
+    checkError();
+}
+
+
+void DataArrayAppender::stop() {
+    if (!writer.joinable()) {
+        return;
+    }
+    stopping = true;
+    data_ready.notify_one();
+    writer.join();
+}
+
+
+void DataArrayAppender::checkError() {
+    if (failed.load(memory_order_acquire)) {
+        rethrow_exception(error);
+    }
+}
+
+
+void DataArrayAppender::run() {
+    const size_t row_bytes = outer * inner_bytes;
+    while (true) {
+        const size_t t = tail.load(memory_order_relaxed);
+        const size_t available = head.load(memory_order_acquire) - t;
+        const bool finish = stopping.load() || flush_target.load() > t;
+
+        // whole chunks as they fill up, everything on flush() and close()
+        size_t n = finish ? available : available - available % flush_rows;
+        if (n == 0) {
+            if (stopping.load()) {
+                return;
+            }
+            unique_lock<mutex> lock(wait_mutex);
+            data_ready.wait_for(lock, max_wait);
+            continue;
+        }
+
+        const size_t first = t % slots;
+        const char *block = ring.data() + first * row_bytes;
+        if (outer > 1 || first + n > slots) {
+            staging.resize(n * row_bytes);
+            for (size_t j = 0; j < n; ++j) {
+                const char *slot = ring.data() + ((t + j) % slots) * row_bytes;
+                for (size_t a = 0; a < outer; ++a) {
+                    memcpy(staging.data() + (a * n + j) * inner_bytes, slot + a * inner_bytes, inner_bytes);
+                }
+            }
+            block = staging.data();
+        }
+
+        NDSize count = row_shape;
+        count[axis] = n;
+        try {
+            array.appendData(dtype, block, count, axis, threads);
+        } catch (...) {
+            error = current_exception();
+            failed.store(true, memory_order_release);
+            space_ready.notify_all();
+            return;
+        }
+
+        tail.store(t + n, memory_order_release);
+        space_ready.notify_all();
+    }
+}
+
+} // namespace util
+} // namespace nix
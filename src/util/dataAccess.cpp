@@ -35,14 +35,18 @@ void scalePositions(const vector<double> &starts, const vector<double> &ends,
     if (scaled_ends.size() != count)
         scaled_ends.resize(count);
     double scaling= 1.0;
+    const string *scaled_unit = nullptr;
     for (size_t i = 0; i < count; ++i) {
-        if (i < units.size() && units[i] != "none" && dim_unit != "none") {
+        // positions usually share one unit, only compute the scaling when it changes
+        if (i < units.size() && units[i] != "none" && dim_unit != "none" &&
+            (scaled_unit == nullptr || *scaled_unit != units[i])) {
             try {
                 scaling = util::getSIScaling(units[i], dim_unit);
             } catch (...) {
                 throw nix::IncompatibleDimensions("Provided units are not scalable!",
                                                   "nix::util::positionToIndex");
             }
+            scaled_unit = &units[i];
         }
         scaled_starts[i] = starts[i] * scaling;
         scaled_ends[i] = ends[i] * scaling;
@@ -409,6 +413,44 @@ void getOffsetAndCount(const Tag &tag, const DataArray &array, NDSize &offset, N
 }
 
 
+// Read the rows of a positions or extents array that belong to the given
+// indices with a single read. Row i of the result holds the width values
+// of row indices[i].
+static vector<double> read_rows(const DataArray &array, const NDSize &shape, size_t width,
+                                const vector<ndsize_t> &indices) {
+    vector<ndsize_t> rows(indices);
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+    // one slab per run of consecutive rows
+    vector<NDSize> offsets, counts;
+    for (ndsize_t row : rows) {
+        if (!offsets.empty() && offsets.back()[0] + counts.back()[0] == row) {
+            counts.back()[0] += 1;
+            continue;
+        }
+        NDSize offset(shape.size(), 0);
+        NDSize count(shape.size(), 1);
+        offset[0] = row;
+        if (shape.size() > 1) {
+            count[1] = width;
+        }
+        offsets.push_back(offset);
+        counts.push_back(count);
+    }
+
+    vector<double> block(rows.size() * width);
+    array.getSlabs(DataType::Double, block.data(), counts, offsets);
+
+    vector<double> values(indices.size() * width);
+    for (size_t i = 0; i < indices.size(); ++i) {
+        size_t row = static_cast<size_t>(std::lower_bound(rows.begin(), rows.end(), indices[i]) - rows.begin());
+        std::copy_n(block.begin() + row * width, width, values.begin() + i * width);
+    }
+    return values;
+}
+
+
 void getOffsetAndCount(const MultiTag &tag, const DataArray &array, const vector<ndsize_t> &indices,
                        vector<NDSize> &offsets, vector<NDSize> &counts, RangeMatch match) {
     DataArray positions = tag.positions();
@@ -421,10 +463,6 @@ void getOffsetAndCount(const MultiTag &tag, const DataArray &array, const vector
     while (units.size() < dimension_count) {
         units.push_back("none");
     }
-    vector<pair<double, double>> max_extents;
-    if (position_size.size() < dimension_count) {
-        max_extents = maximumExtents(array);
-    }
     if (positions) {
         position_size = positions.dataExtent();
     }
@@ -432,29 +470,38 @@ void getOffsetAndCount(const MultiTag &tag, const DataArray &array, const vector
         extent_size = extents.dataExtent();
     }
     ndsize_t max_index = *max_element(indices.begin(), indices.end());
-    if (max_index >= positions.dataExtent()[0] || (extents && max_index >= extents.dataExtent()[0])) {
+    if (max_index >= position_size[0] || (extents && max_index >= extent_size[0])) {
         throw OutOfBounds("Index out of bounds of positions or extents!", 0);
     }
 
     size_t dimcount_sizet = check::fits_in_size_t(dimension_count, "getOffsetAndCount() failed; dimension count > size_t.");
 
-    NDSize temp_offset(positions.dataExtent().size(), static_cast<NDSize::value_type>(0));
-    NDSize temp_count(positions.dataExtent().size(), static_cast<NDSize::value_type>(1));
+    // number of values per position
+    size_t width = dimension_count > 1 && position_size.size() > 1 ?
+                   check::fits_in_size_t(position_size[1], "getOffsetAndCount() failed; position count > size_t.") : 1;
+    vector<pair<double, double>> max_extents;
+    if (width < dimension_count) {
+        max_extents = maximumExtents(array);
+    }
 
-    int dim_index = dimension_count > 1 ? 1 : 0;
-    ndsize_t count = dimension_count > 1 ? position_size[dim_index] : 1;
-    temp_count[dim_index] = static_cast<NDSize::value_type>(count);
+    // the positions and extents of all requested indices, read at once
+    vector<double> position_values = read_rows(positions, position_size, width, indices);
+    vector<double> extent_values;
+    if (extents) {
+        extent_values = read_rows(extents, extent_size, width, indices);
+    }
 
     vector<vector<double>> start_positions(dimension_count);
     vector<vector<double>> end_positions(dimension_count);
     vector<double> offset, extent;
     for (size_t idx = 0; idx < indices.size(); ++idx) {
-        temp_offset[0] = indices[idx];
-        positions.getData(offset, temp_count, temp_offset);
+        auto row = position_values.begin() + idx * width;
+        offset.assign(row, row + width);
         if (extents) {
-            extents.getData(extent, temp_count, temp_offset);
+            row = extent_values.begin() + idx * width;
+            extent.assign(row, row + width);
         } else {
-            extent.resize(offset.size(), 0.0);
+            extent.assign(offset.size(), 0.0);
         }
         // add pos/extents if missing
         while (offset.size() < dimensions.size()) {
@@ -502,7 +549,7 @@ void getOffsetAndCount(const MultiTag &tag, const DataArray &array, const vector
                     if (!ofst) {
                         throw nix::OutOfBounds("util::offsetAndCount:An invalid range was encountered!");
                     }
-                    temp_offset[i] = *ofst;
+                    data_offset[dim_index] = *ofst;
                 }
             }   
         }
@@ -695,6 +742,137 @@ vector<DataView> taggedData(const MultiTag &tag, vector<ndsize_t> &position_indi
 }
 
 
+// The dimension in which the segments differ, if they differ in at most one
+// dimension and all dimensions before it are selected with a count of one.
+// In that case the merged segments are stored one after another.
+static optional<size_t> coalescing_dimension(const vector<NDSize> &offsets, const vector<NDSize> &counts) {
+    size_t rank = offsets[0].size();
+    if (rank == 0) {
+        return boost::none;
+    }
+    optional<size_t> varying;
+    for (size_t d = 0; d < rank; ++d) {
+        for (size_t i = 1; i < offsets.size(); ++i) {
+            if (offsets[i][d] != offsets[0][d] || counts[i][d] != counts[0][d]) {
+                if (varying) {
+                    return boost::none;
+                }
+                varying = d;
+                break;
+            }
+        }
+    }
+    size_t dim = varying ? *varying : 0;
+    for (size_t d = 0; d < dim; ++d) {
+        if (counts[0][d] != 1) {
+            return boost::none;
+        }
+    }
+    return dim;
+}
+
+
+DataSegments dataSegments(const DataArray &array, const vector<NDSize> &offsets, const vector<NDSize> &counts) {
+    if (offsets.size() != counts.size()) {
+        throw std::invalid_argument("util::dataSegments: number of offsets and counts must match!");
+    }
+    if (offsets.empty()) {
+        return DataSegments();
+    }
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        if (!positionAndExtentInData(array, offsets[i], counts[i])) {
+            throw OutOfBounds("Data segment out of the extent of the DataArray!", 0);
+        }
+    }
+
+    size_t n = offsets.size();
+    vector<size_t> starts(n, 0);
+    optional<size_t> dim = coalescing_dimension(offsets, counts);
+    if (!dim) {
+        size_t total = 0;
+        for (size_t i = 0; i < n; ++i) {
+            starts[i] = total;
+            total += check::fits_in_size_t(counts[i].nelms(), "util::dataSegments: segment exceeds memory.");
+        }
+        vector<double> buffer(total);
+        for (size_t i = 0; i < n; ++i) {
+            if (counts[i].nelms() > 0) {
+                array.getData(DataType::Double, buffer.data() + starts[i], counts[i], offsets[i]);
+            }
+        }
+        return DataSegments(std::move(buffer), offsets, counts, std::move(starts));
+    }
+
+    size_t d = *dim;
+    ndsize_t inner = 1;
+    for (size_t k = d + 1; k < counts[0].size(); ++k) {
+        inner *= counts[0][k];
+    }
+
+    vector<size_t> order(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&offsets, d](size_t a, size_t b) {
+        return offsets[a][d] < offsets[b][d];
+    });
+
+    // merge overlapping and adjacent segments into slabs
+    vector<NDSize> slab_offsets, slab_counts;
+    vector<size_t> slab_of(n, 0);
+    for (size_t idx : order) {
+        if (counts[idx].nelms() == 0) {
+            continue;
+        }
+        ndsize_t begin = offsets[idx][d];
+        ndsize_t end = begin + counts[idx][d];
+        if (slab_offsets.empty() || begin > slab_offsets.back()[d] + slab_counts.back()[d]) {
+            slab_offsets.push_back(offsets[idx]);
+            slab_counts.push_back(counts[idx]);
+        } else if (end > slab_offsets.back()[d] + slab_counts.back()[d]) {
+            slab_counts.back()[d] = end - slab_offsets.back()[d];
+        }
+        slab_of[idx] = slab_offsets.size() - 1;
+    }
+
+    vector<size_t> slab_starts(slab_offsets.size());
+    size_t total = 0;
+    for (size_t m = 0; m < slab_offsets.size(); ++m) {
+        slab_starts[m] = total;
+        total += check::fits_in_size_t(slab_counts[m].nelms(), "util::dataSegments: segments exceed memory.");
+    }
+    for (size_t i = 0; i < n; ++i) {
+        if (counts[i].nelms() > 0) {
+            size_t m = slab_of[i];
+            starts[i] = slab_starts[m] + static_cast<size_t>((offsets[i][d] - slab_offsets[m][d]) * inner);
+        }
+    }
+
+    vector<double> buffer(total);
+    array.getSlabs(DataType::Double, buffer.data(), slab_counts, slab_offsets);
+    return DataSegments(std::move(buffer), offsets, counts, std::move(starts));
+}
+
+
+DataSegments taggedDataSegments(const MultiTag &tag, vector<ndsize_t> &position_indices,
+                                const DataArray &array, RangeMatch match) {
+    vector<NDSize> counts, offsets;
+
+    if (position_indices.size() < 1) {
+        size_t pos_count = check::fits_in_size_t(tag.positions().dataExtent()[0],
+                                                 "Number of positions > size_t.");
+        position_indices.resize(pos_count);
+        std::iota(position_indices.begin(), position_indices.end(), 0);
+    }
+
+    getOffsetAndCount(tag, array, position_indices, offsets, counts, match);
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        if (!positionAndExtentInData(array, offsets[i], counts[i])) {
+            throw OutOfBounds("References data slice out of the extent of the DataArray!", 0);
+        }
+    }
+    return dataSegments(array, offsets, counts);
+}
+
+
 DataView retrieveData(const Tag &tag, ndsize_t reference_index, RangeMatch match) {
     return taggedData(tag, reference_index, match);
 }
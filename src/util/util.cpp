@@ -9,9 +9,12 @@
 #include <nix/util/util.hpp>
 
 #include <nix/base/IDimensions.hpp>
+#include <nix/DataType.hpp>
 
 #include <string>
+#include <cstdint>
 #include <cstdlib>
+#include <limits>
 #include <mutex>
 #include <random>
 #include <math.h>
@@ -40,6 +43,47 @@ const map<string, double> PREFIX_FACTORS = {{"y", 1.0e-24}, {"z", 1.0e-21}, {"a"
     {"p", 1.0e-12}, {"n",1.0e-9}, {"u", 1.0e-6}, {"m", 1.0e-3}, {"c", 1.0e-2}, {"d",1.0e-1}, {"da", 1.0e1}, {"h", 1.0e2},
     {"k", 1.0e3}, {"M",1.0e6}, {"G", 1.0e9}, {"T", 1.0e12}, {"P", 1.0e15}, {"E",1.0e18}, {"Z", 1.0e21}, {"Y", 1.0e24}};
 
+// upper bound for the number of memoized unit scalings, see getSIScaling
+const size_t MAX_CACHED_SCALINGS = 1024;
+
+// The unit regexes are compiled once on first use, matching a const
+// boost::regex is safe from multiple threads.
+static const boost::regex &prefixUnitPowerRegex() {
+    static const boost::regex re(PREFIXES + UNITS + POWER);
+    return re;
+}
+
+static const boost::regex &prefixUnitRegex() {
+    static const boost::regex re(PREFIXES + UNITS);
+    return re;
+}
+
+static const boost::regex &unitPowerRegex() {
+    static const boost::regex re(UNITS + POWER);
+    return re;
+}
+
+static const boost::regex &unitRegex() {
+    static const boost::regex re(UNITS);
+    return re;
+}
+
+static const boost::regex &prefixRegex() {
+    static const boost::regex re(PREFIXES);
+    return re;
+}
+
+static const boost::regex &atomicUnitRegex() {
+    static const boost::regex re(PREFIXES + "?" + UNITS + POWER + "?");
+    return re;
+}
+
+static const boost::regex &compoundUnitRegex() {
+    static const string atomic_unit = PREFIXES + "?" + UNITS + POWER + "?";
+    static const boost::regex re("(" + atomic_unit + "(\\*|/))+"+ atomic_unit);
+    return re;
+}
+
 
 string createId() {
     typedef boost::mt19937::result_type seed_type;
@@ -116,11 +160,11 @@ std::string unitSanitizer(const std::string &unit) {
 }
 
 void splitUnit(const string &combinedUnit, string &prefix, string &unit, string &power) {
-    boost::regex prefix_and_unit_and_power(PREFIXES + UNITS + POWER);
-    boost::regex prefix_and_unit(PREFIXES + UNITS);
-    boost::regex unit_and_power(UNITS + POWER);
-    boost::regex unit_only(UNITS);
-    boost::regex prefix_only(PREFIXES);
+    const boost::regex &prefix_and_unit_and_power = prefixUnitPowerRegex();
+    const boost::regex &prefix_and_unit = prefixUnitRegex();
+    const boost::regex &unit_and_power = unitPowerRegex();
+    const boost::regex &unit_only = unitRegex();
+    const boost::regex &prefix_only = prefixRegex();
 
     if (boost::regex_match(combinedUnit, prefix_and_unit_and_power)) {
         boost::match_results<std::string::const_iterator> m;
@@ -169,8 +213,7 @@ void invertPower(std::string &unit) {
 
 void splitCompoundUnit(const std::string &compoundUnit, std::vector<std::string> &atomicUnits) {
     string s = compoundUnit;
-    boost::regex opt_prefix_and_unit_and_power(PREFIXES + "?" + UNITS + POWER + "?");
-    boost::regex separator("(\\*|/)");
+    const boost::regex &opt_prefix_and_unit_and_power = atomicUnitRegex();
     boost::match_results<std::string::const_iterator> m;
     string sep;
     while (boost::regex_search(s, m, opt_prefix_and_unit_and_power) && (m.suffix().length() > 0)) {
@@ -202,15 +245,12 @@ bool isSIUnit(const string &unit) {
 
 
 bool isAtomicSIUnit(const string &unit) {
-    boost::regex opt_prefix_and_unit_and_power(PREFIXES + "?" + UNITS + POWER + "?");
-    return boost::regex_match(unit, opt_prefix_and_unit_and_power);
+    return boost::regex_match(unit, atomicUnitRegex());
 }
 
 
 bool isCompoundSIUnit(const string &unit) {
-    string atomic_unit = PREFIXES + "?" + UNITS + POWER + "?";
-    boost::regex compound_unit("(" + atomic_unit + "(\\*|/))+"+ atomic_unit);
-    return !unit.empty() && boost::regex_match(unit, compound_unit);
+    return !unit.empty() && boost::regex_match(unit, compoundUnitRegex());
 }
 
 
@@ -274,7 +314,7 @@ bool isSetAtSamePos(const vector<string> &unitsA, const vector<string> &unitsB)
 }
 
 
-double getSIScaling(const string &originUnit, const string &destinationUnit) {
+static double computeSIScaling(const string &originUnit, const string &destinationUnit) {
     double scaling = 1.0;
     if (!isScalable(originUnit, destinationUnit)) {
         throw nix::InvalidUnit("Origin unit and destination unit are not scalable versions of the same SI unit!",
@@ -303,31 +343,147 @@ double getSIScaling(const string &originUnit, const string &destinationUnit) {
     return scaling;
 }
 
+
+double getSIScaling(const string &originUnit, const string &destinationUnit) {
+    static std::mutex cache_mutex;
+    static map<pair<string, string>, double> cache;
+
+    pair<string, string> key(originUnit, destinationUnit);
+    {
+        std::lock_guard<std::mutex> lock(cache_mutex);
+        auto it = cache.find(key);
+        if (it != cache.end()) {
+            return it->second;
+        }
+    }
+
+    // throws for units that cannot be scaled, those are not memoized
+    double scaling = computeSIScaling(originUnit, destinationUnit);
+
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    if (cache.size() >= MAX_CACHED_SCALINGS) {
+        cache.clear();
+    }
+    cache.emplace(std::move(key), scaling);
+    return scaling;
+}
+
+// values are calibrated in blocks, the loops over a block are independent
+// per element and are vectorized by the compiler
+static const size_t calibration_block = 256;
+
+
+static void evaluate_polynomial(const vector<double> &coefficients, double *x, size_t m) {
+    if (coefficients.empty()) {
+        return;
+    }
+
+    // Horner's scheme, one coefficient at a time for all values
+    double value[calibration_block];
+    const double highest = coefficients.back();
+    for (size_t k = 0; k < m; k++) {
+        value[k] = highest;
+    }
+    for (size_t i = coefficients.size() - 1; i > 0; i--) {
+        const double c = coefficients[i - 1];
+        for (size_t k = 0; k < m; k++) {
+            value[k] = value[k] * x[k] + c;
+        }
+    }
+    for (size_t k = 0; k < m; k++) {
+        x[k] = value[k];
+    }
+}
+
+
+template<typename T>
+static typename std::enable_if<std::is_floating_point<T>::value, T>::type
+convert_value(double x) {
+    return static_cast<T>(x);
+}
+
+
+template<typename T>
+static typename std::enable_if<std::is_integral<T>::value, T>::type
+convert_value(double x) {
+    const double lo = static_cast<double>(std::numeric_limits<T>::min());
+    const double hi = static_cast<double>(std::numeric_limits<T>::max());
+    if (!(x == x)) {
+        return 0;
+    } else if (x <= lo) {
+        return std::numeric_limits<T>::min();
+    } else if (x >= hi) {
+        return std::numeric_limits<T>::max();
+    }
+    return static_cast<T>(x);
+}
+
+
+template<typename In, typename Out>
+static void calibrate(const vector<double> &coefficients, double origin, const In *input, Out *output, size_t n) {
+    double x[calibration_block];
+    for (size_t start = 0; start < n; start += calibration_block) {
+        const size_t m = std::min(calibration_block, n - start);
+        for (size_t k = 0; k < m; k++) {
+            x[k] = static_cast<double>(input[start + k]) - origin;
+        }
+        evaluate_polynomial(coefficients, x, m);
+        for (size_t k = 0; k < m; k++) {
+            output[start + k] = convert_value<Out>(x[k]);
+        }
+    }
+}
+
+
+template<typename Out>
+static void calibrate_from(const vector<double> &coefficients, double origin, DataType in_type,
+                           const void *input, Out *output, size_t n) {
+    switch (in_type) {
+    case DataType::UInt8:  calibrate(coefficients, origin, static_cast<const uint8_t *>(input), output, n); break;
+    case DataType::UInt16: calibrate(coefficients, origin, static_cast<const uint16_t *>(input), output, n); break;
+    case DataType::UInt32: calibrate(coefficients, origin, static_cast<const uint32_t *>(input), output, n); break;
+    case DataType::UInt64: calibrate(coefficients, origin, static_cast<const uint64_t *>(input), output, n); break;
+    case DataType::Int8:   calibrate(coefficients, origin, static_cast<const int8_t *>(input), output, n); break;
+    case DataType::Int16:  calibrate(coefficients, origin, static_cast<const int16_t *>(input), output, n); break;
+    case DataType::Int32:  calibrate(coefficients, origin, static_cast<const int32_t *>(input), output, n); break;
+    case DataType::Int64:  calibrate(coefficients, origin, static_cast<const int64_t *>(input), output, n); break;
+    case DataType::Float:  calibrate(coefficients, origin, static_cast<const float *>(input), output, n); break;
+    case DataType::Double: calibrate(coefficients, origin, static_cast<const double *>(input), output, n); break;
+    default:
+        throw std::invalid_argument("applyPolynomial: input type must be numeric");
+    }
+}
+
+
 void applyPolynomial(const std::vector<double> &coefficients,
                      double origin,
                      const double *input,
                      double *output,
                      size_t n) {
+    calibrate(coefficients, origin, input, output, n);
+}
 
-    if (!coefficients.size()) {
-        // if we have no coefficients, i.e no polynomial specified we
-        // should still apply the the origin transformation
-        for (size_t k = 0; k < n; k++) {
-            output[k] = input[k] - origin;
-        }
-
-    } else {
 
-        for (size_t k = 0; k < n; k++) {
-            const double x = input[k] - origin;
-            double value = 0.0;
-            double term = 1.0;
-            for (size_t i = 0; i < coefficients.size(); i++) {
-                value += coefficients[i] * term;
-                term *= x;
-            }
-            output[k] = value;
-        }
+void applyPolynomial(const std::vector<double> &coefficients,
+                     double origin,
+                     DataType in_type,
+                     const void *input,
+                     DataType out_type,
+                     void *output,
+                     size_t n) {
+    switch (out_type) {
+    case DataType::UInt8:  calibrate_from(coefficients, origin, in_type, input, static_cast<uint8_t *>(output), n); break;
+    case DataType::UInt16: calibrate_from(coefficients, origin, in_type, input, static_cast<uint16_t *>(output), n); break;
+    case DataType::UInt32: calibrate_from(coefficients, origin, in_type, input, static_cast<uint32_t *>(output), n); break;
+    case DataType::UInt64: calibrate_from(coefficients, origin, in_type, input, static_cast<uint64_t *>(output), n); break;
+    case DataType::Int8:   calibrate_from(coefficients, origin, in_type, input, static_cast<int8_t *>(output), n); break;
+    case DataType::Int16:  calibrate_from(coefficients, origin, in_type, input, static_cast<int16_t *>(output), n); break;
+    case DataType::Int32:  calibrate_from(coefficients, origin, in_type, input, static_cast<int32_t *>(output), n); break;
+    case DataType::Int64:  calibrate_from(coefficients, origin, in_type, input, static_cast<int64_t *>(output), n); break;
+    case DataType::Float:  calibrate_from(coefficients, origin, in_type, input, static_cast<float *>(output), n); break;
+    case DataType::Double: calibrate_from(coefficients, origin, in_type, input, static_cast<double *>(output), n); break;
+    default:
+        throw std::invalid_argument("applyPolynomial: output type must be numeric");
     }
 }
 
@@ -14,9 +14,14 @@
 #include <sstream>
 #include <iterator>
 #include <stdexcept>
+#include <numeric>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 #include <nix/hydra/multiArray.hpp>
 #include <nix/util/dataAccess.hpp>
+#include <nix/util/aggregate.hpp>
 
 #include <cppunit/extensions/HelperMacros.h>
 #include <cppunit/CompilerOutputter.h>
@@ -348,6 +353,17 @@ void BaseTestDataAccess::testRetrieveData() {
     CPPUNIT_ASSERT_NO_THROW(util::retrieveData(mtag2, 0, 0));
     CPPUNIT_ASSERT_NO_THROW(util::retrieveData(mtag2, 0, mtag2.references()[0]));
 
+    // positions and extents of all indices are read at once, order and duplicates must be kept
+    std::vector<ndsize_t> unordered = {3, 0, 3, 1};
+    slices = util::taggedData(mtag2, unordered, 0, RangeMatch::Inclusive);
+    CPPUNIT_ASSERT(slices.size() == unordered.size());
+    for (size_t i = 0; i < unordered.size(); ++i) {
+        std::vector<double> expected, actual;
+        util::taggedData(mtag2, unordered[i], 0, RangeMatch::Inclusive).getData(expected);
+        slices[i].getData(actual);
+        CPPUNIT_ASSERT(expected == actual);
+    }
+
     slices = util::taggedData(pointmtag, temp, 0, RangeMatch::Inclusive);
     CPPUNIT_ASSERT(slices.size() == pointmtag.positions().dataExtent()[0]);
 
@@ -379,6 +395,118 @@ void BaseTestDataAccess::testRetrieveData() {
 }
 
 
+void BaseTestDataAccess::testTaggedDataSegments() {
+    auto check_segments = [](const MultiTag &mtag, const DataArray &array, std::vector<ndsize_t> indices) {
+        DataSegments segments = util::taggedDataSegments(mtag, indices, array);
+        std::vector<DataView> views = util::taggedData(mtag, indices, array);
+        CPPUNIT_ASSERT_EQUAL(views.size(), segments.size());
+        for (size_t i = 0; i < views.size(); ++i) {
+            CPPUNIT_ASSERT_EQUAL(views[i].dataExtent(), segments.count(i));
+            std::vector<double> expected(segments.count(i).nelms());
+            views[i].getData(DataType::Double, expected.data(), segments.count(i), {});
+            std::vector<double> actual(segments.data(i), segments.data(i) + segments.count(i).nelms());
+            CPPUNIT_ASSERT(expected == actual);
+        }
+        return segments;
+    };
+
+    // non-overlapping segments of 1-D data are read into one buffer
+    DataSegments segments = check_segments(mtag2, mtag2.references()[0], {});
+    CPPUNIT_ASSERT_EQUAL(segments.size(), static_cast<size_t>(5));
+
+    // overlapping segments share their data
+    DataArray starts = block.createDataArray("overlap_starts", "test", nix::DataType::Double, NDSize({4}));
+    starts.setData(std::vector<double>{1.0, 1.5, 2.0, 10.0});
+    starts.appendSetDimension();
+    DataArray extents = block.createDataArray("overlap_extents", "test", nix::DataType::Double, NDSize({4}));
+    extents.setData(std::vector<double>{1.0, 1.0, 1.0, 0.5});
+    extents.appendSetDimension();
+    MultiTag overlapping = block.createMultiTag("overlapping", "test", starts);
+    overlapping.extents(extents);
+    segments = check_segments(overlapping, mtag2.references()[0], {});
+    CPPUNIT_ASSERT_EQUAL(segments.size(), static_cast<size_t>(4));
+    CPPUNIT_ASSERT_EQUAL(segments.buffer().size(), static_cast<size_t>(20 + 5));
+
+    // segments of multi-dimensional data
+    check_segments(multi_tag, data_array, {0});
+
+    std::vector<NDSize> offsets = {{0, 0, 0, 0}, {0, 1, 1, 1}};
+    std::vector<NDSize> counts = {{1, 2, 1, 1}, {1, 2, 1, 1}};
+    segments = util::dataSegments(data_array, offsets, counts);
+    for (size_t i = 0; i < offsets.size(); ++i) {
+        std::vector<double> expected(2);
+        data_array.getData(DataType::Double, expected.data(), counts[i], offsets[i]);
+        CPPUNIT_ASSERT(expected == std::vector<double>(segments.data(i), segments.data(i) + 2));
+    }
+    counts[1] = {1, 2, 1, 100};
+    CPPUNIT_ASSERT_THROW(util::dataSegments(data_array, offsets, counts), nix::OutOfBounds);
+
+    block.deleteMultiTag(overlapping);
+    block.deleteDataArray(starts);
+    block.deleteDataArray(extents);
+}
+
+
+void BaseTestDataAccess::testAggregateTaggedData() {
+    DataArray sinus = mtag2.references()[0];
+    std::vector<ndsize_t> indices;
+    std::vector<DataView> views = util::taggedData(mtag2, indices, sinus);
+
+    std::vector<std::vector<double>> windows;
+    for (const DataView &view : views) {
+        std::vector<double> window;
+        view.getData(window);
+        windows.push_back(window);
+    }
+    size_t length = windows[0].size();
+    size_t total = 0;
+    for (const std::vector<double> &w : windows) {
+        total += w.size();
+    }
+
+    for (size_t threads : {1, 3}) {
+        util::Statistics stats;
+        util::aggregateTaggedData(mtag2, sinus, stats, {}, RangeMatch::Exclusive, threads);
+        CPPUNIT_ASSERT(stats.mean().size() == length);
+        for (size_t i = 0; i < length; ++i) {
+            double sum = 0.0, min = windows[0][i], max = windows[0][i];
+            for (const std::vector<double> &w : windows) {
+                sum += w[i];
+                min = std::min(min, w[i]);
+                max = std::max(max, w[i]);
+            }
+            double mean = sum / windows.size();
+            double ss = 0.0;
+            for (const std::vector<double> &w : windows) {
+                ss += (w[i] - mean) * (w[i] - mean);
+            }
+            CPPUNIT_ASSERT(stats.count()[i] == windows.size());
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(mean, stats.mean()[i], 1e-12);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(sum, stats.sum()[i], 1e-12);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(ss / (windows.size() - 1), stats.variance()[i], 1e-12);
+            CPPUNIT_ASSERT_EQUAL(min, stats.min()[i]);
+            CPPUNIT_ASSERT_EQUAL(max, stats.max()[i]);
+        }
+
+        util::Histogram hist({-1.0, -0.5, 0.0, 0.5, 1.0});
+        util::aggregateTaggedData(mtag2, sinus, hist, {}, RangeMatch::Exclusive, threads);
+        ndsize_t counted = std::accumulate(hist.counts().begin(), hist.counts().end(), static_cast<ndsize_t>(0));
+        CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(total), counted + hist.outside());
+        CPPUNIT_ASSERT(hist.outside() == 0);
+    }
+
+    util::Statistics single;
+    util::aggregateTaggedData(mtag2, sinus, single, {2});
+    CPPUNIT_ASSERT(single.mean() == windows[2]);
+    CPPUNIT_ASSERT(std::isnan(single.variance()[0]));
+
+    CPPUNIT_ASSERT_THROW(util::Histogram({1.0}), std::invalid_argument);
+    CPPUNIT_ASSERT_THROW(util::Histogram({1.0, 0.0}), std::invalid_argument);
+    util::Histogram hist({0.0, 1.0});
+    CPPUNIT_ASSERT_THROW(hist.merge(single), std::invalid_argument);
+}
+
+
 void BaseTestDataAccess::testTagFeatureData() {
     DataArray number_feat = block.createDataArray("number feature", "test", nix::DataType::Double, {1});
     std::vector<double> number = {10.0};
@@ -600,6 +728,82 @@ void BaseTestDataAccess::testMultiTagUnitSupport() {
 }
 
 
+void BaseTestDataAccess::testCalibratedView() {
+    // a sine wave stored as raw int16 with a linear calibration
+    std::vector<int16_t> raw(5000);
+    for (size_t i = 0; i < raw.size(); ++i) {
+        raw[i] = static_cast<int16_t>(std::round(1000.0 * std::sin(i * 0.01)));
+    }
+    DataArray da = block.createDataArray("calibrated", "test", DataType::Int16, {raw.size()});
+    da.setData(DataType::Int16, raw.data(), {raw.size()}, {0});
+    da.polynomCoefficients({0.5, -0.002});
+    da.expansionOrigin(10.0);
+
+    CalibratedView view(da, {4000}, {500});
+    CPPUNIT_ASSERT_EQUAL(NDSize({4000}), view.dataExtent());
+    CPPUNIT_ASSERT_EQUAL(10.0, view.expansionOrigin());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), view.polynomCoefficients().size());
+
+    std::vector<double> calibrated(4000);
+    view.getData(DataType::Double, calibrated.data(), {4000}, {});
+    std::vector<int16_t> stored(4000);
+    view.getRawData(DataType::Int16, stored.data(), {4000}, {});
+    for (size_t i = 0; i < stored.size(); ++i) {
+        CPPUNIT_ASSERT_EQUAL(raw[i + 500], stored[i]);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(calibrated[i], view.calibrate(stored[i]), 1e-12);
+    }
+
+    // blocks cover the view exactly once, in order
+    ndsize_t seen = 0;
+    view.forEachBlock([&](const double *values, const NDSize &count, const NDSize &offset) {
+        CPPUNIT_ASSERT_EQUAL(seen, offset[0]);
+        CPPUNIT_ASSERT(count[0] <= 512);
+        for (size_t i = 0; i < count[0]; ++i) {
+            CPPUNIT_ASSERT_EQUAL(calibrated[seen + i], values[i]);
+        }
+        seen += count[0];
+    }, 512);
+    CPPUNIT_ASSERT_EQUAL(static_cast<ndsize_t>(4000), seen);
+
+    std::pair<double, double> range = view.range();
+    CPPUNIT_ASSERT_EQUAL(*std::min_element(calibrated.begin(), calibrated.end()), range.first);
+    CPPUNIT_ASSERT_EQUAL(*std::max_element(calibrated.begin(), calibrated.end()), range.second);
+
+    std::vector<ndsize_t> rising, falling;
+    for (size_t i = 1; i < calibrated.size(); ++i) {
+        if (calibrated[i - 1] < 0.5 && calibrated[i] >= 0.5) {
+            rising.push_back(i);
+        } else if (calibrated[i - 1] > 0.5 && calibrated[i] <= 0.5) {
+            falling.push_back(i);
+        }
+    }
+    CPPUNIT_ASSERT(!rising.empty());
+    CPPUNIT_ASSERT(rising == view.crossings(0.5));
+    CPPUNIT_ASSERT(falling == view.crossings(0.5, false));
+
+    // the raw extremes are found in the stored type, NaN are ignored
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    std::vector<float> floats = {nan, 2.0f, -3.0f, nan};
+    DataArray fa = block.createDataArray("calibrated_floats", "test", DataType::Float, {floats.size()});
+    fa.setData(DataType::Float, floats.data(), {floats.size()}, {0});
+    fa.polynomCoefficients({1.0, 2.0});
+    range = CalibratedView(fa).range();
+    CPPUNIT_ASSERT_EQUAL(-5.0, range.first);
+    CPPUNIT_ASSERT_EQUAL(5.0, range.second);
+    block.deleteDataArray(fa);
+
+    // not monotonic
+    da.polynomCoefficients({0.0, 0.0, 1.0});
+    CalibratedView squared(da);
+    range = squared.range();
+    CPPUNIT_ASSERT_EQUAL(0.0, range.first);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1010.0 * 1010.0, range.second, 1e-6);
+
+    CPPUNIT_ASSERT_THROW(CalibratedView(data_array).crossings(0.0), IncompatibleDimensions);
+    block.deleteDataArray(da);
+}
+
+
 void BaseTestDataAccess::testDataView() {
     NDSize zcount = {2, 5, 2, 5};
     NDSize zoffset = {0, 5, 2, 2};
@@ -38,10 +38,13 @@ public:
     void testOffsetAndCount();
     void testPositionInData();
     void testRetrieveData();
+    void testTaggedDataSegments();
+    void testAggregateTaggedData();
     void testTagFeatureData();
     void testMultiTagFeatureData();
     void testMultiTagUnitSupport();
     void testDataView();
+    void testCalibratedView();
     void testDataSlice();
     void testFlexibleTagging();
 };
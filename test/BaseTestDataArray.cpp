@@ -13,12 +13,14 @@
 #include <iterator>
 #include <stdexcept>
 #include <limits>
+#include <numeric>
 
 #include <boost/math/constants/constants.hpp>
 #include <boost/math/tools/rational.hpp>
 #include <boost/iterator/zip_iterator.hpp>
 
 #include <nix/util/util.hpp>
+#include <nix/util/appender.hpp>
 #include <nix/valid/validate.hpp>
 #include <nix/hydra/multiArray.hpp>
 
@@ -259,6 +261,241 @@ void BaseTestDataArray::testData() {
 }
 
 
+void BaseTestDataArray::testChunking() {
+    AccessHint hint;
+    hint.append_axis = 1;
+    hint.read_box = {1, 30000};
+    hint.workload = AccessHint::Workload::ReadMostly;
+    DataArray da = block.createDataArray("chunked", "test", DataType::Int16, {384, 0}, Compression::Auto, hint);
+    CPPUNIT_ASSERT_EQUAL(NDSize({1, 30000}), da.chunking());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), array2.chunking().size());
+    block.deleteDataArray(da);
+}
+
+
+void BaseTestDataArray::testDataParallel() {
+    const NDSize shape = {500, 40};
+    DataArray da = block.createDataArray("parallel", "test", DataType::Double, shape, Compression::DeflateNormal);
+    std::vector<double> values(shape.nelms());
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = std::sin(i * 0.01) * 100.0;
+    }
+    da.setData(DataType::Double, values.data(), shape, {0, 0});
+
+    std::vector<std::pair<NDSize, NDSize>> boxes = {{shape, {0, 0}}, {{1, 1}, {17, 3}},
+                                                    {{333, 21}, {101, 7}}, {{1, 40}, {499, 0}}};
+    for (const auto &box : boxes) {
+        std::vector<double> expected(box.first.nelms()), actual(box.first.nelms(), -1.0);
+        da.getData(DataType::Double, expected.data(), box.first, box.second);
+        da.getDataParallel(DataType::Double, actual.data(), box.first, box.second, 4);
+        CPPUNIT_ASSERT(expected == actual);
+    }
+
+    // type conversion and calibration
+    da.polynomCoefficients({1.0, 2.0});
+    std::vector<int> expected_int(200 * 40), actual_int(200 * 40);
+    da.getData(DataType::Int32, expected_int.data(), {200, 40}, {100, 0});
+    da.getDataParallel(DataType::Int32, actual_int.data(), {200, 40}, {100, 0}, 3);
+    CPPUNIT_ASSERT(expected_int == actual_int);
+    da.polynomCoefficients(nix::none);
+
+    // chunks that were never written hold the fill value
+    da.dataExtent({900, 40});
+    std::vector<double> expected(800 * 40), actual(800 * 40, -1.0);
+    da.getData(DataType::Double, expected.data(), {800, 40}, {100, 0});
+    da.getDataParallel(DataType::Double, actual.data(), {800, 40}, {100, 0});
+    CPPUNIT_ASSERT(expected == actual);
+
+    block.deleteDataArray(da);
+}
+
+
+void BaseTestDataArray::testSetDataParallel() {
+    const NDSize shape = {600, 48};
+    DataArray serial = block.createDataArray("serial", "test", DataType::Double, shape, Compression::DeflateNormal);
+    DataArray parallel = block.createDataArray("parallel", "test", DataType::Double, shape, Compression::DeflateNormal);
+    std::vector<double> values(shape.nelms());
+    for (size_t i = 0; i < values.size(); ++i) {
+        values[i] = std::cos(i * 0.003) * 1000.0;
+    }
+
+    // unaligned boxes exercise both the direct chunk writes and the regular ones
+    std::vector<std::pair<NDSize, NDSize>> boxes = {{{501, 45}, {3, 2}}, {{1, 48}, {599, 0}},
+                                                    {{100, 48}, {0, 0}}};
+    for (const auto &box : boxes) {
+        serial.setData(DataType::Double, values.data(), box.first, box.second);
+        parallel.setDataParallel(DataType::Double, values.data(), box.first, box.second, 4);
+    }
+    std::vector<double> expected(shape.nelms()), actual(shape.nelms());
+    serial.getData(DataType::Double, expected.data(), shape, {0, 0});
+    parallel.getData(DataType::Double, actual.data(), shape, {0, 0});
+    CPPUNIT_ASSERT(expected == actual);
+
+    // with type conversion
+    std::vector<int> ints(shape.nelms(), 7);
+    parallel.setDataParallel(DataType::Int32, ints.data(), shape, {0, 0});
+    parallel.getData(DataType::Double, actual.data(), shape, {0, 0});
+    CPPUNIT_ASSERT(std::all_of(actual.begin(), actual.end(), [](double x) { return x == 7.0; }));
+
+    CPPUNIT_ASSERT_THROW(parallel.setDataParallel(DataType::Double, values.data(), shape, {1, 0}), OutOfBounds);
+
+    serial.dataExtent({0, 48});
+    parallel.dataExtent({0, 48});
+    for (size_t i = 0; i < 5; ++i) {
+        serial.appendData(DataType::Double, values.data(), {120, 48}, 0);
+        parallel.appendData(DataType::Double, values.data(), {120, 48}, 0, 3);
+    }
+    CPPUNIT_ASSERT_EQUAL(shape, parallel.dataExtent());
+    serial.getData(DataType::Double, expected.data(), shape, {0, 0});
+    parallel.getData(DataType::Double, actual.data(), shape, {0, 0});
+    CPPUNIT_ASSERT(expected == actual);
+
+    block.deleteDataArray(serial);
+    block.deleteDataArray(parallel);
+}
+
+
+void BaseTestDataArray::testAppender() {
+    // channels x time, appended along time in small blocks
+    const ndsize_t channels = 6, block_rows = 7, blocks = 50;
+    DataArray traces = block.createDataArray("traces", "test", DataType::Int16, {6, 0}, Compression::None);
+    std::vector<int16_t> expected(channels * block_rows * blocks);
+    {
+        util::DataArrayAppender appender(traces, DataType::Int16, 1, 16, 64);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(64), appender.capacity());
+        std::vector<int16_t> values(channels * block_rows);
+        for (size_t b = 0; b < blocks; ++b) {
+            for (size_t c = 0; c < channels; ++c) {
+                for (size_t j = 0; j < block_rows; ++j) {
+                    int16_t v = static_cast<int16_t>(c * 1000 + b * block_rows + j);
+                    values[c * block_rows + j] = v;
+                    expected[c * block_rows * blocks + b * block_rows + j] = v;
+                }
+            }
+            appender.append(values.data(), block_rows);
+            if (b == blocks / 2) {
+                appender.flush();
+                CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), appender.pending());
+                CPPUNIT_ASSERT_EQUAL(NDSize({channels, (b + 1) * block_rows}), traces.dataExtent());
+            }
+        }
+        // more rows than the buffer holds
+        CPPUNIT_ASSERT(!appender.tryAppend(expected.data(), 100));
+        appender.close();
+        CPPUNIT_ASSERT_THROW(appender.append(values.data(), 1), std::runtime_error);
+    }
+    CPPUNIT_ASSERT_EQUAL(NDSize({channels, block_rows * blocks}), traces.dataExtent());
+    std::vector<int16_t> actual(expected.size());
+    traces.getData(DataType::Int16, actual.data(), traces.dataExtent(), {0, 0});
+    CPPUNIT_ASSERT(expected == actual);
+
+    // along the first axis, blocks larger than the buffer and the destructor flushing
+    DataArray rows = block.createDataArray("rows", "test", DataType::Double, {0, 3}, Compression::None);
+    std::vector<double> values(300 * 3);
+    std::iota(values.begin(), values.end(), 0.0);
+    {
+        util::DataArrayAppender appender(rows, DataType::Double, 0, 8, 32);
+        appender.append(values.data(), 1);
+        appender.append(values.data() + 3, 299);
+    }
+    CPPUNIT_ASSERT_EQUAL(NDSize({300, 3}), rows.dataExtent());
+    std::vector<double> read(values.size());
+    rows.getData(DataType::Double, read.data(), rows.dataExtent(), {0, 0});
+    CPPUNIT_ASSERT(values == read);
+
+    CPPUNIT_ASSERT_THROW(util::DataArrayAppender(rows, DataType::Double, 2), InvalidRank);
+
+    block.deleteDataArray(traces);
+    block.deleteDataArray(rows);
+}
+
+
+void BaseTestDataArray::testCachedMetadata() {
+    DataArray da = block.createDataArray("cached", "test", DataType::Double, {4}, Compression::None);
+    std::vector<double> values = {1.0, 2.0, 3.0, 4.0};
+    da.setData(DataType::Double, values.data(), {4}, {0});
+    std::vector<double> read(4);
+    da.getData(DataType::Double, read.data(), {4}, {0});
+    CPPUNIT_ASSERT(values == read);
+
+    // the calibration is cached, writing it has to be seen by the next read
+    da.polynomCoefficients({0.0, 2.0});
+    da.getData(DataType::Double, read.data(), {4}, {0});
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(8.0, read[3], 1e-12);
+    da.expansionOrigin(1.0);
+    da.getData(DataType::Double, read.data(), {4}, {0});
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(6.0, read[3], 1e-12);
+    da.polynomCoefficients(none);
+    da.expansionOrigin(none);
+    da.getData(DataType::Double, read.data(), {4}, {0});
+    CPPUNIT_ASSERT(values == read);
+
+    // the extent is taken from the open data set, so changes by other handles are seen
+    DataArray other = block.getDataArray(da.id());
+    other.appendData(DataType::Double, values.data(), {4}, 0);
+    CPPUNIT_ASSERT_EQUAL(NDSize({8}), da.dataExtent());
+    CPPUNIT_ASSERT_EQUAL(DataType::Double, da.dataType());
+    da.getData(DataType::Double, read.data(), {4}, {4});
+    CPPUNIT_ASSERT(values == read);
+
+    block.deleteDataArray(da);
+}
+
+
+void BaseTestDataArray::testDataSpan() {
+    DataArray da = block.createDataArray("span", "test", DataType::Int32, {6, 8}, Compression::None);
+    std::vector<int32_t> values(6 * 8);
+    std::iota(values.begin(), values.end(), 0);
+    da.setData(DataType::Int32, values.data(), {6, 8}, {0, 0});
+
+    // dense, the same buffer is reused
+    std::vector<int32_t> row(8, -1);
+    DataSpan dense(row.data(), {1, 8});
+    CPPUNIT_ASSERT(dense.contiguous());
+    NDSize offset = {0, 0};
+    for (ndsize_t r = 0; r < 6; r++) {
+        offset[0] = r;
+        da.getData(dense, offset);
+        CPPUNIT_ASSERT(std::equal(row.begin(), row.end(), values.begin() + r * 8));
+    }
+
+    // a 3 x 4 block into the middle of a 5 x 10 image, every other column
+    std::vector<int32_t> image(5 * 10, -1);
+    DataSpan region(image.data() + 11, {3, 4}, {10, 2});
+    CPPUNIT_ASSERT(!region.contiguous());
+    CPPUNIT_ASSERT(region.nested());
+    da.getData(region, {2, 3});
+    for (size_t i = 0; i < 5; i++) {
+        for (size_t j = 0; j < 10; j++) {
+            bool inside = i >= 1 && i < 4 && j >= 1 && j < 9 && (j - 1) % 2 == 0;
+            int32_t expected = inside ? values[(i - 1 + 2) * 8 + (j - 1) / 2 + 3] : -1;
+            CPPUNIT_ASSERT_EQUAL(expected, image[i * 10 + j]);
+        }
+    }
+
+    // transposed (column-major) is not nested and read through a copy
+    std::vector<double> transposed(6 * 8);
+    DataSpan columns(transposed.data(), {6, 8}, {1, 6});
+    CPPUNIT_ASSERT(!columns.nested());
+    da.getData(columns, {0, 0});
+    for (size_t i = 0; i < 6; i++) {
+        for (size_t j = 0; j < 8; j++) {
+            CPPUNIT_ASSERT_EQUAL(static_cast<double>(values[i * 8 + j]), transposed[j * 6 + i]);
+        }
+    }
+
+    // calibrated data goes through the dense path
+    da.polynomCoefficients({0.0, 2.0});
+    std::fill(image.begin(), image.end(), -1);
+    da.getData(region, {2, 3});
+    CPPUNIT_ASSERT_EQUAL(2 * values[2 * 8 + 3], image[11]);
+    CPPUNIT_ASSERT_EQUAL(-1, image[12]);
+
+    CPPUNIT_ASSERT_THROW(DataSpan(image.data(), {3, 4}, {10}), IncompatibleDimensions);
+    block.deleteDataArray(da);
+}
+
+
 void BaseTestDataArray::testPolynomial() {
     double PI = boost::math::constants::pi<double>();
     boost::array<double, 10> coefficients1;
@@ -338,6 +575,38 @@ void BaseTestDataArray::testPolynomial() {
     for (size_t i = 0; i < dvin_poly.size(); i++) {
         CPPUNIT_ASSERT_EQUAL(static_cast<int32_t >(dv[i]-origin), dvin_poly[i]);
     }
+
+    // raw int16 samples, calibrated straight into the requested type
+    std::vector<int16_t> raw(1000);
+    for (size_t i = 0; i < raw.size(); i++) {
+        raw[i] = static_cast<int16_t>(i * 37 % 2001) - 1000;
+    }
+    nix::DataArray dai = block.createDataArray("polyraw", "int16", nix::DataType::Int16, nix::NDSize({1000}));
+    dai.setData(nix::DataType::Int16, raw.data(), nix::NDSize({1000}), nix::NDSize({0}));
+    dai.polynomCoefficients({0.5, 0.25, 0.001});
+    dai.expansionOrigin(-2.0);
+    std::vector<double> calibrated(raw.size());
+    std::vector<float> calibrated_float(raw.size());
+    std::vector<int8_t> calibrated_int8(raw.size());
+    dai.getData(DataType::Double, calibrated.data(), nix::NDSize({1000}), nix::NDSize({0}));
+    dai.getData(DataType::Float, calibrated_float.data(), nix::NDSize({1000}), nix::NDSize({0}));
+    dai.getData(DataType::Int8, calibrated_int8.data(), nix::NDSize({1000}), nix::NDSize({0}));
+    for (size_t i = 0; i < raw.size(); i++) {
+        const double x = raw[i] + 2.0;
+        const double expected = 0.5 + 0.25 * x + 0.001 * x * x;
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(expected, calibrated[i], 1e-9);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(expected, calibrated_float[i], 1e-3);
+        // truncated and clipped like HDF5 converts
+        const double clipped = std::max(-128.0, std::min(127.0, std::trunc(expected)));
+        CPPUNIT_ASSERT_EQUAL(static_cast<int>(clipped), static_cast<int>(calibrated_int8[i]));
+    }
+
+    std::vector<double> nan = {std::numeric_limits<double>::quiet_NaN(), -1e30, 1e30};
+    std::vector<uint16_t> converted(nan.size());
+    util::applyPolynomial({}, 0.0, DataType::Double, nan.data(), DataType::UInt16, converted.data(), nan.size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<uint16_t>(0), converted[0]);
+    CPPUNIT_ASSERT_EQUAL(static_cast<uint16_t>(0), converted[1]);
+    CPPUNIT_ASSERT_EQUAL(std::numeric_limits<uint16_t>::max(), converted[2]);
 }
 
 
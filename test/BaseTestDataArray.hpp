@@ -31,6 +31,12 @@ public:
     void testDefinition();
     void testData();
     void testPolynomial();
+    void testChunking();
+    void testDataParallel();
+    void testSetDataParallel();
+    void testAppender();
+    void testCachedMetadata();
+    void testDataSpan();
     void testPolynomialSetter();
     void testLabel();
     void testUnit();
@@ -127,6 +127,75 @@ void BaseTestDataFrame::testRowIO() {
 
 }
 
+void BaseTestDataFrame::testBulkRowIO() {
+    nix::DataFrame df = createStandardFrame(block);
+
+    std::vector<std::vector<nix::Variant>> batch;
+    for (int i = 0; i < 100; i++) {
+        batch.push_back({nix::Variant(i), nix::Variant("row"), nix::Variant(i * 0.5)});
+    }
+
+    // many small batches, the rows must stay consecutive
+    for (int k = 0; k < 10; k++) {
+        std::vector<std::vector<nix::Variant>> part(batch.begin() + k * 10, batch.begin() + (k + 1) * 10);
+        CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(k * 10), df.appendRows(part));
+        CPPUNIT_ASSERT_EQUAL(nix::ndsize_t((k + 1) * 10), df.rows());
+    }
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(100), df.appendRows({}));
+
+    // the capacity reserved by appending is not part of the frame
+    std::vector<nix::Variant> beyond = {nix::Variant(99), nix::Variant("beyond"), nix::Variant(9.9)};
+    CPPUNIT_ASSERT_THROW(df.writeRow(102, beyond), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(df.writeCell(100, 0, nix::Variant(99)), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(df.readRow(105), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(df.readCell(100, "int32"), nix::OutOfBounds);
+    std::vector<int32_t> tail(5, 99);
+    CPPUNIT_ASSERT_THROW(df.writeColumn("int32", tail, 98), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(df.readColumn("int32", tail, 5, false, 98), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(df.readColumns({"int32"}, 98, 5, tail), nix::OutOfBounds);
+    df.rows(103);
+    CPPUNIT_ASSERT_EQUAL(nix::Variant(int32_t(0)), df.readRow(102)[0]);
+    df.rows(100);
+
+    for (size_t i = 0; i < batch.size(); i += 33) {
+        std::vector<nix::Variant> rr = df.readRow(i);
+        for (size_t j = 0; j < rr.size(); j++) {
+            CPPUNIT_ASSERT_EQUAL(batch[i][j], rr[j]);
+        }
+    }
+
+    // rows with different value types are converted like single rows
+    std::vector<std::vector<nix::Variant>> mixed = {
+        {nix::Variant(int64_t(-7)), nix::Variant("a"), nix::Variant(1.5)},
+        {nix::Variant(int64_t(-8)), nix::Variant("b"), nix::Variant(2.5)},
+        {nix::Variant(uint32_t(9)), nix::Variant("c"), nix::Variant(3.5)}
+    };
+    df.writeRows(50, mixed);
+    CPPUNIT_ASSERT_EQUAL(nix::Variant(int32_t(-7)), df.readRow(50)[0]);
+    CPPUNIT_ASSERT_EQUAL(nix::Variant(int32_t(-8)), df.readRow(51)[0]);
+    CPPUNIT_ASSERT_EQUAL(nix::Variant(int32_t(9)), df.readRow(52)[0]);
+    CPPUNIT_ASSERT_EQUAL(nix::Variant("c"), df.readRow(52)[1]);
+    CPPUNIT_ASSERT_EQUAL(nix::Variant(int32_t(53)), df.readRow(53)[0]);
+
+    CPPUNIT_ASSERT_THROW(df.writeRows(99, mixed), nix::OutOfBounds);
+
+    // shrinking and growing again behaves like before
+    df.rows(90);
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(90), df.rows());
+    df.rows(95);
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(95), df.rows());
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(95), df.appendRows(mixed));
+
+    // the reserved capacity is released on close
+    std::string name = df.name();
+    file.close();
+    file = nix::File::open("test_DataFrame.h5", nix::FileMode::ReadOnly);
+    block = file.getBlock("b1");
+    df = block.getDataFrame(name);
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(98), df.rows());
+    CPPUNIT_ASSERT_EQUAL(nix::Variant(int32_t(9)), df.readRow(97)[0]);
+}
+
 void BaseTestDataFrame::testColIO() {
     nix::DataFrame df = createStandardFrame(block);
     size_t n = 10;
@@ -216,6 +285,295 @@ void BaseTestDataFrame::testColIO() {
     CPPUNIT_ASSERT_THROW(df.readColumn(0, i32_rs, n, false), nix::OutOfBounds);
 }
 
+void BaseTestDataFrame::testColumnsIO() {
+    nix::DataFrame df = createStandardFrame(block);
+
+    const size_t n = 50;
+    std::vector<std::vector<nix::Variant>> rows;
+    for (size_t i = 0; i < n; i++) {
+        rows.push_back({nix::Variant(int32_t(i)), nix::Variant("s" + std::to_string(i)), nix::Variant(i * 0.25)});
+    }
+    df.appendRows(rows);
+
+    std::vector<double> dbl;
+    std::vector<int32_t> i32;
+    std::vector<std::string> str;
+    df.readColumns({"double", "int32", "string"}, 10, 20, dbl, i32, str);
+
+    CPPUNIT_ASSERT_EQUAL(size_t(20), dbl.size());
+    CPPUNIT_ASSERT_EQUAL(size_t(20), i32.size());
+    CPPUNIT_ASSERT_EQUAL(size_t(20), str.size());
+    for (size_t i = 0; i < 20; i++) {
+        CPPUNIT_ASSERT_EQUAL((i + 10) * 0.25, dbl[i]);
+        CPPUNIT_ASSERT_EQUAL(int32_t(i + 10), i32[i]);
+        CPPUNIT_ASSERT_EQUAL("s" + std::to_string(i + 10), str[i]);
+    }
+
+    // converted to the type of the vector
+    std::vector<int64_t> i64;
+    df.readColumns(df.colName(std::vector<unsigned>{0}), 0, n, i64);
+    CPPUNIT_ASSERT_EQUAL(n, i64.size());
+    CPPUNIT_ASSERT_EQUAL(int64_t(n - 1), i64[n - 1]);
+
+    CPPUNIT_ASSERT_THROW(df.readColumns({"int32"}, 40, 20, i32), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(df.readColumns({"int32", "double"}, 0, 1, i32), std::invalid_argument);
+    CPPUNIT_ASSERT_THROW(df.readColumns({"int32", "int32"}, 0, 1, i32, i64), std::invalid_argument);
+    CPPUNIT_ASSERT_THROW(df.impl()->readColumns({"int32", "double"}, 0, 1, {nix::DataType::Int32}, {i32.data()}),
+                         std::invalid_argument);
+}
+
+void BaseTestDataFrame::testFilter() {
+    nix::DataFrame df = createStandardFrame(block);
+    typedef nix::Condition::Op Op;
+
+    std::vector<std::vector<nix::Variant>> rows;
+    for (int32_t i = 0; i < 100; i++) {
+        rows.push_back({nix::Variant(i % 5), nix::Variant(i % 2 ? "odd" : "even"), nix::Variant(i * 0.01)});
+    }
+    df.appendRows(rows);
+
+    std::vector<nix::ndsize_t> hits = df.filter({{"int32", Op::Equal, 3}, {"double", Op::Less, 0.5}});
+    std::vector<nix::ndsize_t> expected = {3, 8, 13, 18, 23, 28, 33, 38, 43, 48};
+    CPPUNIT_ASSERT(hits == expected);
+
+    // integer columns against floating point values, conditions on the same column
+    hits = df.filter({{"int32", Op::Greater, 3.5}, {"int32", Op::LessEqual, 4}, {"string", Op::Equal, "odd"}});
+    CPPUNIT_ASSERT_EQUAL(size_t(10), hits.size());
+    for (nix::ndsize_t h : hits) {
+        CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(9), h % 10);
+    }
+
+    std::vector<bool> mask = df.filterMask({{"string", Op::NotEqual, "odd"}});
+    CPPUNIT_ASSERT_EQUAL(size_t(100), mask.size());
+    for (size_t i = 0; i < mask.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(i % 2 == 0, bool(mask[i]));
+    }
+
+    CPPUNIT_ASSERT_EQUAL(size_t(100), df.filter({}).size());
+    CPPUNIT_ASSERT(df.filter({{"double", Op::GreaterEqual, 2.0}}).empty());
+
+    CPPUNIT_ASSERT_THROW(df.filter({{"nope", Op::Equal, 1}}), std::invalid_argument);
+    CPPUNIT_ASSERT_THROW(df.filter({{"string", Op::Equal, 1}}), std::invalid_argument);
+}
+
+void BaseTestDataFrame::testIndex() {
+    nix::DataFrame df = createStandardFrame(block);
+
+    std::vector<std::vector<nix::Variant>> rows;
+    for (int32_t i = 0; i < 200; i++) {
+        rows.push_back({nix::Variant((i * 37) % 50), nix::Variant("k" + std::to_string(i % 7)), nix::Variant(i * 0.5)});
+    }
+    df.appendRows(rows);
+
+    std::vector<nix::ndsize_t> scanned = df.lookup("int32", nix::Variant(13));
+    std::vector<nix::ndsize_t> scanned_range = df.lookup("double", nix::Variant(10.0), nix::Variant(20));
+    std::vector<nix::ndsize_t> scanned_str = df.lookup("string", nix::Variant("k3"));
+    CPPUNIT_ASSERT_EQUAL(size_t(4), scanned.size());
+    CPPUNIT_ASSERT_EQUAL(size_t(21), scanned_range.size());
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(20), scanned_range[0]);
+
+    CPPUNIT_ASSERT(!df.hasIndex("int32"));
+    df.createIndex("int32");
+    df.createIndex("double");
+    df.createIndex("string");
+    CPPUNIT_ASSERT(df.hasIndex("int32"));
+
+    CPPUNIT_ASSERT(scanned == df.lookup("int32", nix::Variant(13)));
+    CPPUNIT_ASSERT(scanned_range == df.lookup("double", nix::Variant(10.0), nix::Variant(20)));
+    CPPUNIT_ASSERT(scanned_str == df.lookup("string", nix::Variant("k3")));
+    CPPUNIT_ASSERT(df.lookup("int32", nix::Variant(50)).empty());
+    CPPUNIT_ASSERT(df.lookup("int32", nix::Variant(12.5)).empty());
+    CPPUNIT_ASSERT_EQUAL(size_t(8), df.lookup("int32", nix::Variant(12.5), nix::Variant(14)).size());
+    CPPUNIT_ASSERT_EQUAL(size_t(200), df.lookup("int32", nix::Variant(-5), nix::Variant(100)).size());
+
+    // single rows and appends keep the indexes up to date, also with NaN keys
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    df.writeCell(0, 0, nix::Variant(13));
+    df.writeRow(1, {nix::Variant(13), nix::Variant("k3"), nix::Variant(nan)});
+    df.appendRows({{nix::Variant(13), nix::Variant("k3"), nix::Variant(15.0)},
+                   {nix::Variant(-1), nix::Variant("a"), nix::Variant(nan)}});
+    df.rows(203);
+
+    std::vector<nix::ndsize_t> hits = df.lookup("int32", nix::Variant(13));
+    std::vector<nix::ndsize_t> expected = df.filter({{"int32", nix::Condition::Op::Equal, 13}});
+    CPPUNIT_ASSERT(hits == expected);
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(0), hits[0]);
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(200), hits.back());
+    CPPUNIT_ASSERT_EQUAL(scanned_range.size() + 1, df.lookup("double", nix::Variant(10.0), nix::Variant(20)).size());
+    CPPUNIT_ASSERT_EQUAL(size_t(201), df.lookup("double", nix::Variant(-1.0), nix::Variant(1e9)).size());
+    CPPUNIT_ASSERT(df.lookup("double", nix::Variant(nan), nix::Variant(nan)).empty());
+
+    // the backend answers only from an up to date index, which a read-only file keeps as it is
+    const std::string id = df.id();
+    const std::string block_id = block.id();
+    const std::string location = file.location();
+    auto indexed = [](const nix::DataFrame &frame, const std::string &name, int64_t value) {
+        std::vector<nix::ndsize_t> found;
+        return frame.impl()->lookup(name, nix::DataType::Int64, &value, &value, found);
+    };
+    file.close();
+    file = nix::File::open(location, nix::FileMode::ReadOnly);
+    block = file.getBlock(block_id);
+    df = block.getDataFrame(id);
+    CPPUNIT_ASSERT(indexed(df, "int32", 13));
+    CPPUNIT_ASSERT(df.lookup("int32", nix::Variant(13)) == expected);
+    CPPUNIT_ASSERT(df.lookup("string", nix::Variant("k3")) == df.filter({{"string", nix::Condition::Op::Equal, "k3"}}));
+    CPPUNIT_ASSERT(df.lookup("double", nix::Variant(0.0), nix::Variant(50.0)) ==
+                   df.filter({{"double", nix::Condition::Op::GreaterEqual, 0.0},
+                              {"double", nix::Condition::Op::LessEqual, 50.0}}));
+
+    // large writes only outdate the indexes of the columns they touch
+    file.close();
+    file = nix::File::open(location, nix::FileMode::ReadWrite);
+    block = file.getBlock(block_id);
+    df = block.getDataFrame(id);
+    std::vector<int32_t> column(100, 13);
+    df.writeColumn("int32", column, 2);
+    file.close();
+    file = nix::File::open(location, nix::FileMode::ReadOnly);
+    block = file.getBlock(block_id);
+    df = block.getDataFrame(id);
+    CPPUNIT_ASSERT(!indexed(df, "int32", 13));
+    CPPUNIT_ASSERT(indexed(df, "double", 0));
+
+    // lookups scan the column until createIndex rebuilds the outdated index
+    file.close();
+    file = nix::File::open(location, nix::FileMode::ReadWrite);
+    block = file.getBlock(block_id);
+    df = block.getDataFrame(id);
+    df.writeRows(1, {{nix::Variant(13), nix::Variant("k3"), nix::Variant(1000.0)}});
+    hits = df.lookup("int32", nix::Variant(13));
+    expected = df.filter({{"int32", nix::Condition::Op::Equal, 13}});
+    CPPUNIT_ASSERT(hits == expected);
+    CPPUNIT_ASSERT(!indexed(df, "int32", 13));
+    df.createIndex("int32");
+    CPPUNIT_ASSERT(indexed(df, "int32", 13));
+    CPPUNIT_ASSERT(df.lookup("int32", nix::Variant(13)) == expected);
+    CPPUNIT_ASSERT_EQUAL(size_t(105), hits.size());
+
+    // lookups by value of a DataFrameDimension
+    nix::DataArray da = block.createDataArray("indexed", "test", nix::DataType::Double, nix::NDSize({203}));
+    nix::DataFrameDimension dim = da.appendDataFrameDimension(df, 0);
+    CPPUNIT_ASSERT(dim.lookup(nix::Variant(13)) == expected);
+    CPPUNIT_ASSERT(dim.lookup(nix::Variant("k3"), 1u) == df.lookup("string", nix::Variant("k3")));
+
+    CPPUNIT_ASSERT(df.deleteIndex("int32"));
+    CPPUNIT_ASSERT(!df.deleteIndex("int32"));
+    CPPUNIT_ASSERT(df.lookup("int32", nix::Variant(13)) == expected);
+
+    // column names are not used as hdf5 link names
+    std::vector<nix::Column> odd = {
+        {"spikes/s", "Hz", nix::DataType::Double},
+        {".", "", nix::DataType::Int64}};
+    nix::DataFrame of = block.createDataFrame("odd", "frame", odd);
+    of.appendRows({{nix::Variant(2.5), nix::Variant(int64_t(1))},
+                   {nix::Variant(0.5), nix::Variant(int64_t(2))}});
+    CPPUNIT_ASSERT(!of.hasIndex("spikes/s"));
+    of.createIndex("spikes/s");
+    CPPUNIT_ASSERT(of.hasIndex("spikes/s"));
+    CPPUNIT_ASSERT(!of.hasIndex("."));
+    CPPUNIT_ASSERT(!of.hasIndex("missing"));
+    CPPUNIT_ASSERT(of.lookup("spikes/s", nix::Variant(2.5)) == std::vector<nix::ndsize_t>{0});
+    CPPUNIT_ASSERT(of.deleteIndex("spikes/s"));
+}
+
+void BaseTestDataFrame::testColumnarLayout() {
+    std::vector<nix::Column> cols = {
+        {"int32", "V", nix::DataType::Int32},
+        {"string", "", nix::DataType::String},
+        {"double", "mV", nix::DataType::Double}};
+    nix::DataFrame df = block.createDataFrame("columnar", "frame", cols, nix::Compression::DeflateNormal,
+                                              nix::DataFrameLayout::Columns);
+    CPPUNIT_ASSERT(df.layout() == nix::DataFrameLayout::Columns);
+    CPPUNIT_ASSERT(createStandardFrame(block).layout() == nix::DataFrameLayout::Rows);
+
+    std::vector<nix::Column> cs = df.columns();
+    CPPUNIT_ASSERT_EQUAL(cols.size(), cs.size());
+    for (size_t i = 0; i < cols.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(cols[i].name, cs[i].name);
+        CPPUNIT_ASSERT_EQUAL(cols[i].unit, cs[i].unit);
+        CPPUNIT_ASSERT_EQUAL(cols[i].dtype, cs[i].dtype);
+    }
+    CPPUNIT_ASSERT_EQUAL(2u, df.colIndex("double"));
+    CPPUNIT_ASSERT_EQUAL(std::string("string"), df.colName(1));
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(0), df.rows());
+
+    // rows
+    std::vector<std::vector<nix::Variant>> rows;
+    for (int32_t i = 0; i < 100; i++) {
+        rows.push_back({nix::Variant(i % 10), nix::Variant("r" + std::to_string(i)), nix::Variant(i * 0.5)});
+    }
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(0), df.appendRows(rows));
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(100), df.rows());
+
+    std::vector<nix::Variant> row = df.readRow(42);
+    for (size_t i = 0; i < row.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(rows[42][i], row[i]);
+    }
+
+    std::vector<nix::Variant> vals = {nix::Variant(int64_t(77)), nix::Variant("new"), nix::Variant(-1.0)};
+    df.writeRow(3, vals);
+    row = df.readRow(3);
+    CPPUNIT_ASSERT_EQUAL(nix::Variant(int32_t(77)), row[0]);
+    CPPUNIT_ASSERT_EQUAL(nix::Variant("new"), row[1]);
+
+    // cells
+    df.writeCell(4, 2, nix::Variant(99.0));
+    df.writeCells(5, {{"string", nix::Variant("five")}});
+    CPPUNIT_ASSERT_EQUAL(nix::Variant(99.0), df.readCell(4, "double"));
+    std::vector<nix::Cell> cells = df.readCells(5, {"string", "int32"});
+    CPPUNIT_ASSERT_EQUAL(nix::Variant("five"), static_cast<const nix::Variant &>(cells[0]));
+    CPPUNIT_ASSERT_EQUAL(std::string("int32"), cells[1].name);
+    CPPUNIT_ASSERT_EQUAL(nix::Variant(int32_t(5)), static_cast<const nix::Variant &>(cells[1]));
+
+    // columns
+    std::vector<double> dbl(10, 1.25);
+    df.writeColumn("double", dbl, 90);
+    std::vector<double> dbl_out;
+    std::vector<std::string> str_out;
+    df.readColumns({"double", "string"}, 88, 12, dbl_out, str_out);
+    CPPUNIT_ASSERT_EQUAL(44.0, dbl_out[0]);
+    CPPUNIT_ASSERT_EQUAL(1.25, dbl_out[11]);
+    CPPUNIT_ASSERT_EQUAL(std::string("r99"), str_out[11]);
+
+    std::vector<int32_t> i32;
+    df.readColumn("int32", i32, true);
+    CPPUNIT_ASSERT_EQUAL(size_t(100), i32.size());
+
+    // filters and indexes work on top of the column access
+    std::vector<nix::ndsize_t> hits = df.filter({{"int32", nix::Condition::Op::Equal, 7}});
+    CPPUNIT_ASSERT_EQUAL(size_t(10), hits.size());
+    df.createIndex("int32");
+    CPPUNIT_ASSERT(hits == df.lookup("int32", nix::Variant(7)));
+
+    df.rows(50);
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(50), df.rows());
+    CPPUNIT_ASSERT_EQUAL(size_t(5), df.lookup("int32", nix::Variant(7)).size());
+
+    // column names are not used as hdf5 link names
+    std::vector<nix::Column> odd = {
+        {"spikes/s", "Hz", nix::DataType::Double},
+        {".", "", nix::DataType::Int64}};
+    nix::DataFrame of = block.createDataFrame("odd", "frame", odd, nix::Compression::Auto,
+                                              nix::DataFrameLayout::Columns);
+    of.appendRows({{nix::Variant(2.5), nix::Variant(int64_t(1))},
+                   {nix::Variant(0.5), nix::Variant(int64_t(2))}});
+    CPPUNIT_ASSERT_EQUAL(std::string("spikes/s"), of.columns()[0].name);
+    CPPUNIT_ASSERT_EQUAL(nix::Variant(0.5), of.readCell(1, "spikes/s"));
+    CPPUNIT_ASSERT_EQUAL(nix::Variant(int64_t(1)), of.readCell(0, "."));
+    of.createIndex("spikes/s");
+    CPPUNIT_ASSERT(of.lookup("spikes/s", nix::Variant(2.5)) == std::vector<nix::ndsize_t>{0});
+
+    std::string name = df.name();
+    file.close();
+    file = nix::File::open("test_DataFrame.h5", nix::FileMode::ReadOnly);
+    block = file.getBlock("b1");
+    df = block.getDataFrame(name);
+    CPPUNIT_ASSERT(df.layout() == nix::DataFrameLayout::Columns);
+    CPPUNIT_ASSERT_EQUAL(nix::ndsize_t(50), df.rows());
+    CPPUNIT_ASSERT_EQUAL(nix::Variant("r42"), df.readCell(42, "string"));
+}
+
 void BaseTestDataFrame::testCellIO() {
     nix::DataFrame df = createStandardFrame(block);
 
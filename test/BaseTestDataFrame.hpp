@@ -26,7 +26,12 @@ protected:
 public:
     void testBasic();
     void testRowIO();
+    void testBulkRowIO();
     void testColIO();
+    void testColumnsIO();
+    void testFilter();
+    void testIndex();
+    void testColumnarLayout();
     void testCellIO();
 };
 
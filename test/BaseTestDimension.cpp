@@ -339,6 +339,23 @@ void BaseTestDimension::testSampledDimIndexOf() {
     CPPUNIT_ASSERT(ranges[2] && (*ranges[2]).first == 2 && (*ranges[2]).second == 40 && 
                    sd.positionAt((*ranges[2]).first) == 1.0 && sd.positionAt((*ranges[2]).second) == 39);
     CPPUNIT_ASSERT(!ranges[3]);
+
+    // flat batch version must agree with the scalar one
+    std::vector<double> starts = {1.0, 12.0, 1.0, 5.0, -3.0, 2.0, -1.5, 0.0};
+    std::vector<double> ends = {10.9, 20.0, 40.0, 5.0, -2.0, -2.0, 2.0, 0.0};
+    std::vector<ndsize_t> start_indices, end_indices;
+    std::vector<char> valid;
+    for (RangeMatch match : {RangeMatch::Inclusive, RangeMatch::Exclusive}) {
+        sd.indexOf(starts, ends, match, start_indices, end_indices, valid);
+        CPPUNIT_ASSERT(valid.size() == starts.size());
+        for (size_t i = 0; i < starts.size(); ++i) {
+            boost::optional<std::pair<ndsize_t, ndsize_t>> r = sd.indexOf(starts[i], ends[i], match);
+            CPPUNIT_ASSERT(static_cast<bool>(valid[i]) == static_cast<bool>(r));
+            if (r) {
+                CPPUNIT_ASSERT(start_indices[i] == (*r).first && end_indices[i] == (*r).second);
+            }
+        }
+    }
     data_array.deleteDimensions();
 }
 
@@ -830,7 +847,24 @@ void BaseTestDimension::testRangeDimIndexOf() {
     CPPUNIT_ASSERT(!optranges[0]);
     CPPUNIT_ASSERT(optranges[1] && (*optranges[1]).first == 0 && (*optranges[1]).second == 3);
     CPPUNIT_ASSERT(optranges[2] && (*optranges[2]).first == 0 && (*optranges[2]).second == 4);
-    
+
+    std::vector<boost::optional<ndsize_t>> indices;
+    indices = rd.indexOf({-110., -50., 10., 110.}, PositionMatch::GreaterOrEqual);
+    CPPUNIT_ASSERT(indices.size() == 4);
+    CPPUNIT_ASSERT(*indices[0] == 0 && *indices[1] == 1 && *indices[2] == 3 && !indices[3]);
+
+    // the cached ticks are replaced when new ticks are set
+    rd.ticks({0.0, 1.0, 2.0});
+    CPPUNIT_ASSERT(*rd.indexOf(1.5, PositionMatch::GreaterOrEqual) == 2);
+    CPPUNIT_ASSERT(rd.tickAt(2) == 2.0);
+    CPPUNIT_ASSERT(rd.positionInRange(50.0) == PositionInRange::Greater);
+
+    CPPUNIT_ASSERT(rd.impl()->tickCount() == 3);
+    CPPUNIT_ASSERT(rd.impl()->lowerBound(-1.0) == 0);
+    CPPUNIT_ASSERT(rd.impl()->lowerBound(1.0) == 1);
+    CPPUNIT_ASSERT(rd.impl()->lowerBound(1.5) == 2);
+    CPPUNIT_ASSERT(rd.impl()->lowerBound(3.0) == 3);
+
     data_array.deleteDimensions();
 }
 
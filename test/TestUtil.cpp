@@ -52,6 +52,10 @@ void TestUtil::testUnitScaling() {
     CPPUNIT_ASSERT(util::getSIScaling("V","mV") == 1e+03);
     CPPUNIT_ASSERT(util::getSIScaling("V^2","mV^2") == 1e+06);
     CPPUNIT_ASSERT(util::getSIScaling("mV^2","kV^2") == 1e-12);
+
+    // memoized results must be the same and failures must not be cached
+    CPPUNIT_ASSERT(util::getSIScaling("mV","kV") == 1e-6);
+    CPPUNIT_ASSERT_THROW(util::getSIScaling("mOhm","ms"), nix::InvalidUnit);
 }
 
 void TestUtil::testIsSIUnit() {
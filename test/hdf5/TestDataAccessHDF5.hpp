@@ -26,10 +26,13 @@ class TestDataAccessHDF5 : public BaseTestDataAccess {
     CPPUNIT_TEST(testOffsetAndCount);
     CPPUNIT_TEST(testPositionInData);
     CPPUNIT_TEST(testRetrieveData);
+    CPPUNIT_TEST(testTaggedDataSegments);
+    CPPUNIT_TEST(testAggregateTaggedData);
     CPPUNIT_TEST(testTagFeatureData);
     CPPUNIT_TEST(testMultiTagFeatureData);
     CPPUNIT_TEST(testMultiTagUnitSupport);
     CPPUNIT_TEST(testDataView);
+    CPPUNIT_TEST(testCalibratedView);
     CPPUNIT_TEST(testDataSlice);
     CPPUNIT_TEST(testFlexibleTagging);
     CPPUNIT_TEST(testGetDimensionUnit);
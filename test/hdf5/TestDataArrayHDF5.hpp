@@ -22,6 +22,12 @@ class TestDataArrayHDF5 : public BaseTestDataArray {
     CPPUNIT_TEST(testDefinition);
     CPPUNIT_TEST(testData);
     CPPUNIT_TEST(testPolynomial);
+    CPPUNIT_TEST(testChunking);
+    CPPUNIT_TEST(testDataParallel);
+    CPPUNIT_TEST(testSetDataParallel);
+    CPPUNIT_TEST(testAppender);
+    CPPUNIT_TEST(testCachedMetadata);
+    CPPUNIT_TEST(testDataSpan);
     CPPUNIT_TEST(testPolynomialSetter);
     CPPUNIT_TEST(testLabel);
     CPPUNIT_TEST(testUnit);
@@ -18,7 +18,12 @@ class TestDataFrameHDF5 : public BaseTestDataFrame {
     CPPUNIT_TEST_SUITE(TestDataFrameHDF5);
     CPPUNIT_TEST(testBasic);
     CPPUNIT_TEST(testRowIO);
+    CPPUNIT_TEST(testBulkRowIO);
     CPPUNIT_TEST(testColIO);
+    CPPUNIT_TEST(testColumnsIO);
+    CPPUNIT_TEST(testFilter);
+    CPPUNIT_TEST(testIndex);
+    CPPUNIT_TEST(testColumnarLayout);
     CPPUNIT_TEST(testCellIO);
     CPPUNIT_TEST_SUITE_END ();
 
@@ -90,6 +90,75 @@ void TestDataSet::testChunkGuessing() {
 }
 
 
+void TestDataSet::testChunkChoice() {
+    const NDSize dims = {384, 0};
+
+    AccessHint hint;
+    CPPUNIT_ASSERT(hdf5::DataSet::chooseChunking(dims, 2, hint) == hdf5::DataSet::guessChunking(dims, 2));
+
+    // appending all channels at once: chunks span all channels
+    hint.append_axis = 1;
+    hint.workload = AccessHint::Workload::WriteMostly;
+    NDSize chunks = hdf5::DataSet::chooseChunking(dims, 2, hint);
+    CPPUNIT_ASSERT_EQUAL(NDSize({384, 1024}), chunks);
+
+    // reading single channels: chunks hold one channel
+    hint.read_box = {1, 30000};
+    hint.workload = AccessHint::Workload::ReadMostly;
+    chunks = hdf5::DataSet::chooseChunking(dims, 2, hint);
+    CPPUNIT_ASSERT_EQUAL(NDSize({1, 30000}), chunks);
+
+    hint.read_box = {1, 1000};
+    chunks = hdf5::DataSet::chooseChunking(dims, 2, hint);
+    CPPUNIT_ASSERT_EQUAL(NDSize({1, 32000}), chunks);
+
+    // without an append axis chunks grow along the longest side of the box
+    AccessHint box;
+    box.read_box = {4, 100};
+    chunks = hdf5::DataSet::chooseChunking({1000, 1000}, 8, box);
+    CPPUNIT_ASSERT_EQUAL(NDSize({32, 1000}), chunks);
+
+    // a box that is larger than the target is halved
+    box.read_box = {1000, 1000};
+    chunks = hdf5::DataSet::chooseChunking({1000, 1000}, 8, box);
+    CPPUNIT_ASSERT(chunks.nelms() * 8 <= 256 * 1024);
+
+    hint.append_axis = 2;
+    CPPUNIT_ASSERT_THROW(hdf5::DataSet::chooseChunking(dims, 2, hint), OutOfBounds);
+    hint.append_axis = 1;
+    hint.read_box = {1};
+    CPPUNIT_ASSERT_THROW(hdf5::DataSet::chooseChunking(dims, 2, hint), IncompatibleDimensions);
+}
+
+
+void TestDataSet::testChunkCacheSizing() {
+    const NDSize chunks = {1, 262144}; // 2 MiB of doubles
+
+    ChunkCache sized = hdf5::DataSet::sizeChunkCache(ChunkCache(), chunks, 8, {4, 1000}, {0, 0});
+    CPPUNIT_ASSERT(sized.mode == ChunkCache::Mode::Default);
+
+    sized = hdf5::DataSet::sizeChunkCache(ChunkCache::fixed(64 * 1024 * 1024), chunks, 8, {}, {});
+    CPPUNIT_ASSERT(sized.mode == ChunkCache::Mode::Fixed);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(64 * 1024 * 1024), sized.bytes);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3203), sized.slots); // first prime >= 32 chunks * 100
+
+    sized = hdf5::DataSet::sizeChunkCache(ChunkCache::fixed(1024, 7), chunks, 8, {}, {});
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(7), sized.slots);
+
+    // auto: all chunks touched by the box fit
+    sized = hdf5::DataSet::sizeChunkCache(ChunkCache::automatic(), chunks, 8, {4, 1000}, {0, 262000});
+    CPPUNIT_ASSERT(sized.mode == ChunkCache::Mode::Fixed);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(8 * 2 * 1024 * 1024), sized.bytes);
+
+    sized = hdf5::DataSet::sizeChunkCache(ChunkCache::automatic(4 * 1024 * 1024), chunks, 8, {4, 1000}, {0, 0});
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(4 * 1024 * 1024), sized.bytes);
+
+    // never smaller than the default of the library
+    sized = hdf5::DataSet::sizeChunkCache(ChunkCache::automatic(), {10}, 8, {5}, {0});
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1024 * 1024), sized.bytes);
+}
+
+
 void TestDataSet::testDataType() {
     static struct _type_info {
         std::string name;
@@ -193,6 +262,7 @@ void TestDataSet::testBasic() {
     CPPUNIT_ASSERT_EQUAL(dsZero.size(), (NDSize{0, 0}));
 
     hdf5::DataSet ds = h5group.createData("dsDouble", H5T_NATIVE_DOUBLE, dims);
+    CPPUNIT_ASSERT_EQUAL(ds.chunking().size(), static_cast<size_t>(2));
 
     test_refcounting<hdf5::DataSet>(dsZero.h5id(), ds.h5id());
 
@@ -332,3 +402,61 @@ void TestDataSet::tearDown() {
     h5group.close();
     H5Fclose(h5file);
 }
+
+
+static std::vector<H5Z_filter_t> filter_ids(const hdf5::DataSet &ds) {
+    hid_t dcpl = H5Dget_create_plist(ds.h5id());
+    std::vector<H5Z_filter_t> ids;
+    int n = H5Pget_nfilters(dcpl);
+    for (int i = 0; i < n; i++) {
+        unsigned flags, config;
+        size_t nelms = 0;
+        ids.push_back(H5Pget_filter2(dcpl, static_cast<unsigned>(i), &flags, &nelms, nullptr, 0, nullptr, &config));
+    }
+    H5Pclose(dcpl);
+    return ids;
+}
+
+
+void TestDataSet::testCompression() {
+    typedef std::vector<H5Z_filter_t> filters;
+    const NDSize size = {2048, 16};
+    hdf5::h5x::DataType i16 = H5T_STD_I16LE;
+
+    CPPUNIT_ASSERT_THROW(Compression::deflate(10), std::invalid_argument);
+    CPPUNIT_ASSERT(!Compression::None.enabled());
+    CPPUNIT_ASSERT(Compression::DeflateNormal == Compression::deflate());
+    CPPUNIT_ASSERT(Compression::deflate(1) != Compression::deflate(1).shuffle(true));
+
+    hdf5::DataSet ds = h5group.createData("compressionNone", i16, size, Compression::None);
+    CPPUNIT_ASSERT(filter_ids(ds).empty());
+
+    Compression all = Compression::deflate(3).shuffle(true).fletcher32(true).scaleOffset(0);
+    ds = h5group.createData("compressionAll", i16, size, all);
+    CPPUNIT_ASSERT(filter_ids(ds) == filters({H5Z_FILTER_SCALEOFFSET, H5Z_FILTER_SHUFFLE,
+                                              H5Z_FILTER_DEFLATE, H5Z_FILTER_FLETCHER32}));
+
+    std::vector<int16_t> values(size.nelms());
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = static_cast<int16_t>(i % 1000 - 500);
+    }
+    ds.write(values.data(), hdf5::h5x::DataType(H5T_NATIVE_INT16), size);
+    std::vector<int16_t> read(values.size());
+    ds.read(read.data(), hdf5::h5x::DataType(H5T_NATIVE_INT16), size);
+    CPPUNIT_ASSERT(values == read);
+
+    // scale-offset only applies to integer data
+    ds = h5group.createData("compressionDouble", H5T_NATIVE_DOUBLE, size, all);
+    CPPUNIT_ASSERT(filter_ids(ds) == filters({H5Z_FILTER_SHUFFLE, H5Z_FILTER_DEFLATE, H5Z_FILTER_FLETCHER32}));
+
+    // unknown plugins fall back to deflate
+    ds = h5group.createData("compressionPlugin", i16, size, Compression::filter(31999, {1}, 2).shuffle(true));
+    CPPUNIT_ASSERT(filter_ids(ds) == filters({H5Z_FILTER_SHUFFLE, H5Z_FILTER_DEFLATE}));
+
+    ds = h5group.createData("compressionAuto", i16, size, Compression::Auto);
+    CPPUNIT_ASSERT(filter_ids(ds) == filters({H5Z_FILTER_SHUFFLE, H5Z_FILTER_DEFLATE}));
+    ds = h5group.createData("compressionAutoSmall", i16, {16}, Compression::Auto);
+    CPPUNIT_ASSERT(filter_ids(ds).empty());
+    ds = h5group.createData("compressionAutoString", hdf5::h5x::DataType::makeStrType(), size, Compression::Auto);
+    CPPUNIT_ASSERT(filter_ids(ds).empty());
+}
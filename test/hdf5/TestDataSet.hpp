@@ -33,6 +33,8 @@ public:
 
     void setUp();
     void testChunkGuessing();
+    void testChunkChoice();
+    void testChunkCacheSizing();
     void testDataType();
     void testDataTypeFromString();
     void testDataTypeIsNumeric();
@@ -40,6 +42,7 @@ public:
     void testNDArrayIO();
     void testValArrayIO();
     void testOpaqueIO();
+    void testCompression();
     void tearDown();
 
 private:
@@ -51,6 +54,8 @@ private:
 
     CPPUNIT_TEST_SUITE(TestDataSet);
     CPPUNIT_TEST(testChunkGuessing);
+    CPPUNIT_TEST(testChunkChoice);
+    CPPUNIT_TEST(testChunkCacheSizing);
     CPPUNIT_TEST(testDataType);
     CPPUNIT_TEST(testDataTypeFromString);
     CPPUNIT_TEST(testDataTypeIsNumeric);
@@ -58,6 +63,7 @@ private:
     CPPUNIT_TEST(testNDArrayIO);
     CPPUNIT_TEST(testValArrayIO);
     CPPUNIT_TEST(testOpaqueIO);
+    CPPUNIT_TEST(testCompression);
     CPPUNIT_TEST_SUITE_END ();
 };
 
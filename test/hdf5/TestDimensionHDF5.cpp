@@ -0,0 +1,61 @@
+// Copyright (c) 2015, German Neuroinformatics Node (G-Node)
+//
+// All rights reserved.
+//
+// Redistribution and use in Section and binary forms, with or without
+// modification, are permitted under the terms of the BSD License. See
+// LICENSE file in the root of the Project.
+
+#include "TestDimensionHDF5.hpp"
+
+#include "hdf5/DimensionHDF5.hpp"
+#include "hdf5/h5x/H5DataType.hpp"
+
+#include <algorithm>
+
+namespace hdf5 = nix::hdf5;
+
+
+void TestDimensionHDF5::testRangeDimLowerBound() {
+    hdf5::H5Object fid = H5Fcreate("test_range_lower_bound.h5", H5F_ACC_TRUNC, H5P_DEFAULT, H5P_DEFAULT);
+    fid.check("Could not create plain h5 file");
+    hdf5::H5Group root = H5Gopen(fid.h5id(), "/", H5P_DEFAULT);
+    hdf5::H5Group group = root.openGroup("dimension", true);
+
+    // 100 even ticks in chunks of 8, so that the on-disk search visits many blocks
+    std::vector<double> ticks(100);
+    for (size_t i = 0; i < ticks.size(); i++) {
+        ticks[i] = 2.0 * static_cast<double>(i);
+    }
+    hdf5::h5x::DataType fileType = hdf5::data_type_to_h5_filetype(nix::DataType::Double);
+    hdf5::DataSet ds = group.createData("ticks", fileType, {ticks.size()}, nix::Compression::None, {}, {8}, true, false);
+    ds.write(ticks);
+
+    hdf5::RangeDimensionHDF5 cached(group, 1);
+    hdf5::RangeDimensionHDF5 searched(group, 1);
+    searched.maxCachedTicks(10);
+    CPPUNIT_ASSERT(cached.cachedTicks());
+    CPPUNIT_ASSERT(!searched.cachedTicks());
+
+    for (double position = -3.0; position <= 202.0; position += 0.5) {
+        nix::ndsize_t expected = std::lower_bound(ticks.begin(), ticks.end(), position) - ticks.begin();
+        CPPUNIT_ASSERT_EQUAL(expected, cached.lowerBound(position));
+        CPPUNIT_ASSERT_EQUAL(expected, searched.lowerBound(position));
+    }
+
+    // the first ticks of the blocks, and the positions around them
+    for (nix::ndsize_t block = 0; block < 100; block += 8) {
+        double first = ticks[block];
+        CPPUNIT_ASSERT_EQUAL(block, searched.lowerBound(first));
+        CPPUNIT_ASSERT_EQUAL(block, searched.lowerBound(first - 1e-9));
+        CPPUNIT_ASSERT_EQUAL(block + 1, searched.lowerBound(first + 1e-9));
+    }
+    CPPUNIT_ASSERT_EQUAL(static_cast<nix::ndsize_t>(0), searched.lowerBound(-1e9));
+    CPPUNIT_ASSERT_EQUAL(static_cast<nix::ndsize_t>(99), searched.lowerBound(198.0));
+    CPPUNIT_ASSERT_EQUAL(static_cast<nix::ndsize_t>(100), searched.lowerBound(198.5));
+    CPPUNIT_ASSERT_EQUAL(static_cast<nix::ndsize_t>(100), searched.lowerBound(1e9));
+
+    // raising the limit loads the ticks again
+    searched.maxCachedTicks(hdf5::RangeDimensionHDF5::default_max_cached_ticks);
+    CPPUNIT_ASSERT(searched.cachedTicks());
+}
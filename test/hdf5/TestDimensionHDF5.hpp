@@ -36,6 +36,7 @@ class TestDimensionHDF5 : public BaseTestDimension {
     CPPUNIT_TEST(testRangeTicks);
     CPPUNIT_TEST(testRangeDimIndexOfOld);
     CPPUNIT_TEST(testRangeDimIndexOf);
+    CPPUNIT_TEST(testRangeDimLowerBound);
     CPPUNIT_TEST(testRangeDimPositionInRange);
     CPPUNIT_TEST(testRangeDimTickAt);
     CPPUNIT_TEST(testRangeDimAxis);
@@ -44,6 +45,8 @@ class TestDimensionHDF5 : public BaseTestDimension {
     CPPUNIT_TEST_SUITE_END ();
 
 public:
+    void testRangeDimLowerBound();
+
     void setUp() {
         file = nix::File::open("test_dimension.h5", nix::FileMode::Overwrite);
         block = file.createBlock("dimensionTest","test");
@@ -13,8 +13,11 @@
 #include "hdf5/h5x/H5Object.hpp"
 #include "hdf5/h5x/H5Group.hpp"
 #include "hdf5/FileHDF5.hpp"
+#include "hdf5/DataArrayHDF5.hpp"
+#include "hdf5/DimensionHDF5.hpp"
 
 #include <sstream>
+#include <algorithm>
 #include <nix/util/util.hpp>
 
 namespace h5x = nix::hdf5;
@@ -116,3 +119,222 @@ void TestFileHDF5::testVersion() {
         f.close();
     }
 }
+
+
+void TestFileHDF5::testIdIndex() {
+    std::vector<std::string> ids;
+    std::string block_id;
+
+    nix::File f = nix::File::open("test_id_index.h5", nix::FileMode::Overwrite, "hdf5",
+                                  nix::Compression::None, nix::OpenFlags::IdIndex);
+    nix::Block b = f.createBlock("block", "test");
+    block_id = b.id();
+    for (int i = 0; i < 5; i++) {
+        nix::DataArray da = b.createDataArray("da_" + std::to_string(i), "test", nix::DataType::Double, {1});
+        ids.push_back(da.id());
+    }
+    ids.push_back(b.createTag("tag", "test", {1.0}).id());
+    f.close();
+
+    h5x::H5Object fid = H5Fopen("test_id_index.h5", H5F_ACC_RDONLY, H5P_DEFAULT);
+    h5x::H5Group root = H5Gopen(fid.h5id(), "/", H5P_DEFAULT);
+    h5x::H5Group table = root.openGroup("data", false).openGroup("block", false).openGroup("id_index", false);
+    std::vector<std::string> stored;
+    CPPUNIT_ASSERT(table.getData("entity_id", stored));
+    CPPUNIT_ASSERT_EQUAL(ids.size(), stored.size());
+    CPPUNIT_ASSERT(std::is_sorted(stored.begin(), stored.end()));
+    root.close();
+    fid.close();
+
+    f = nix::File::open("test_id_index.h5", nix::FileMode::ReadOnly);
+    b = f.getBlock(block_id);
+    for (size_t i = 0; i < 5; i++) {
+        nix::DataArray da = b.getDataArray(ids[i]);
+        CPPUNIT_ASSERT(da);
+        CPPUNIT_ASSERT_EQUAL(ids[i], da.id());
+    }
+    CPPUNIT_ASSERT(b.hasTag(ids[5]));
+    CPPUNIT_ASSERT(!b.hasDataArray(ids[5]));
+    f.close();
+
+    // a file modified without the flag leaves a stale table behind,
+    // lookups must fall back to scanning
+    f = nix::File::open("test_id_index.h5", nix::FileMode::ReadWrite);
+    b = f.getBlock(block_id);
+    b.deleteDataArray(ids[0]);
+    std::string added = b.createDataArray("added", "test", nix::DataType::Double, {1}).id();
+    f.close();
+
+    f = nix::File::open("test_id_index.h5", nix::FileMode::ReadOnly);
+    b = f.getBlock(block_id);
+    CPPUNIT_ASSERT(!b.hasDataArray(ids[0]));
+    CPPUNIT_ASSERT(b.hasDataArray(ids[1]));
+    CPPUNIT_ASSERT(b.hasDataArray(added));
+    f.close();
+}
+
+
+void TestFileHDF5::testIdIndexFailure() {
+    nix::File f = nix::File::open("test_id_index_failure.h5", nix::FileMode::Overwrite);
+    f.createBlock("block", "test");
+    f.close();
+
+    // a data set in place of the table makes writing the index fail
+    h5x::H5Object fid = H5Fopen("test_id_index_failure.h5", H5F_ACC_RDWR, H5P_DEFAULT);
+    h5x::H5Group root = H5Gopen(fid.h5id(), "/", H5P_DEFAULT);
+    root.openGroup("data", false).openGroup("block", false).setData("id_index", std::vector<int>{0});
+    root.close();
+    fid.close();
+
+    H5E_auto2_t print;
+    void *print_data;
+    H5Eget_auto2(H5E_DEFAULT, &print, &print_data);
+    H5Eset_auto2(H5E_DEFAULT, nullptr, nullptr);
+
+    f = nix::File::open("test_id_index_failure.h5", nix::FileMode::ReadWrite, "hdf5",
+                        nix::Compression::None, nix::OpenFlags::IdIndex);
+    CPPUNIT_ASSERT_THROW(f.close(), std::exception);
+    CPPUNIT_ASSERT(!f.isOpen());
+
+    // the destructor swallows the error
+    {
+        nix::File other = nix::File::open("test_id_index_failure.h5", nix::FileMode::ReadWrite, "hdf5",
+                                          nix::Compression::None, nix::OpenFlags::IdIndex);
+        CPPUNIT_ASSERT(other.getBlock("block"));
+    }
+
+    H5Eset_auto2(H5E_DEFAULT, print, print_data);
+
+    f = nix::File::open("test_id_index_failure.h5", nix::FileMode::ReadOnly);
+    CPPUNIT_ASSERT(f.getBlock("block"));
+    f.close();
+}
+
+
+static nix::ChunkCache applied_cache(const nix::DataArray &da) {
+    return std::dynamic_pointer_cast<h5x::DataArrayHDF5>(da.impl())->appliedChunkCache();
+}
+
+
+void TestFileHDF5::testChunkCache() {
+    nix::File f = nix::File::open("test_chunk_cache.h5", nix::FileMode::Overwrite, "hdf5",
+                                  nix::Compression::DeflateNormal, nix::OpenFlags::None,
+                                  nix::ChunkCache::fixed(8 * 1024 * 1024));
+    CPPUNIT_ASSERT(f.chunkCache().mode == nix::ChunkCache::Mode::Fixed);
+    CPPUNIT_ASSERT(file_open.chunkCache().mode == nix::ChunkCache::Mode::Default);
+
+    nix::Block b = f.createBlock("block", "test");
+    nix::DataArray da = b.createDataArray("da", "test", nix::DataType::Int32, {300, 300});
+    CPPUNIT_ASSERT(da.chunkCache().mode == nix::ChunkCache::Mode::Fixed);
+
+    std::vector<int> values(300 * 300);
+    for (size_t i = 0; i < values.size(); i++) {
+        values[i] = static_cast<int>(i);
+    }
+    da.setData(nix::DataType::Int32, values.data(), {300, 300}, {0, 0});
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(8 * 1024 * 1024), applied_cache(da).bytes);
+
+    da.chunkCache(nix::ChunkCache::automatic(4 * 1024 * 1024));
+    CPPUNIT_ASSERT(da.chunkCache().mode == nix::ChunkCache::Mode::Auto);
+    std::vector<int> row(300);
+    da.getData(nix::DataType::Int32, row.data(), {1, 300}, {17, 0});
+    CPPUNIT_ASSERT(std::equal(row.begin(), row.end(), values.begin() + 17 * 300));
+    // an automatic cache only grows, so the larger fixed one is kept
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(8 * 1024 * 1024), applied_cache(da).bytes);
+
+    // the setting belongs to the object, not to the data array in the file
+    CPPUNIT_ASSERT(b.getDataArray("da").chunkCache().mode == nix::ChunkCache::Mode::Fixed);
+
+    // HDF5 keeps the cache of a data set that is open through another object
+    nix::DataArray other = b.getDataArray("da");
+    other.chunkCache(nix::ChunkCache::fixed(1024 * 1024));
+    other.getData(nix::DataType::Int32, row.data(), {1, 300}, {17, 0});
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(8 * 1024 * 1024), applied_cache(other).bytes);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(8 * 1024 * 1024), applied_cache(da).bytes);
+
+    da = nix::DataArray();
+    other.chunkCache(nix::ChunkCache::fixed(2 * 1024 * 1024));
+    other.getData(nix::DataType::Int32, row.data(), {1, 300}, {17, 0});
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2 * 1024 * 1024), applied_cache(other).bytes);
+    f.close();
+}
+
+
+static nix::NDSize stored_extent(const std::string &path) {
+    h5x::H5Object fid = H5Fopen("test_grow_extents.h5", H5F_ACC_RDONLY, H5P_DEFAULT);
+    h5x::DataSet ds = H5Dopen(fid.h5id(), path.c_str(), H5P_DEFAULT);
+    return ds.size();
+}
+
+
+void TestFileHDF5::testGrowExtents() {
+    const std::string path = "/data/block/data_arrays/da/data";
+    nix::File f = nix::File::open("test_grow_extents.h5", nix::FileMode::Overwrite, "hdf5",
+                                  nix::Compression::None, nix::OpenFlags::GrowExtents);
+    nix::Block b = f.createBlock("block", "test");
+    nix::DataArray da = b.createDataArray("da", "test", nix::DataType::Int32, {0, 4});
+
+    std::vector<int> block(10 * 4);
+    for (int i = 0; i < 100; i++) {
+        std::fill(block.begin(), block.end(), i);
+        da.appendData(nix::DataType::Int32, block.data(), {10, 4}, 0);
+    }
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({1000, 4}), da.dataExtent());
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({1000, 4}), b.getDataArray("da").dataExtent());
+    nix::NDSize capacity = stored_extent(path);
+    CPPUNIT_ASSERT(capacity[0] > 1000);
+    CPPUNIT_ASSERT_EQUAL(static_cast<nix::ndsize_t>(4), capacity[1]);
+
+    // the reserved space is not part of the data
+    CPPUNIT_ASSERT_THROW(da.getData(nix::DataType::Int32, block.data(), {10, 4}, {995, 0}), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(da.setData(nix::DataType::Int32, block.data(), {10, 4}, {995, 0}), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(da.getData(nix::DataType::Int32, block.data(), {1, 4}, {1000, 0}), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(da.setData(nix::DataType::Int32, block.data(), {1, 4}, {1000, 0}), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(da.getDataParallel(nix::DataType::Int32, block.data(), {10, 4}, {995, 0}, 2), nix::OutOfBounds);
+    CPPUNIT_ASSERT_THROW(da.setDataParallel(nix::DataType::Int32, block.data(), {10, 4}, {995, 0}, 2), nix::OutOfBounds);
+
+    std::vector<int> values(1000 * 4);
+    da.getData(nix::DataType::Int32, values.data(), {1000, 4}, {0, 0});
+    for (size_t i = 0; i < values.size(); i++) {
+        CPPUNIT_ASSERT_EQUAL(static_cast<int>(i / 40), values[i]);
+    }
+
+    // shrinking is done right away, growing again starts from the smaller extent
+    da.dataExtent({500, 4});
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({500, 4}), stored_extent(path));
+    da.dataExtent({600, 4});
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({600, 4}), da.dataExtent());
+    da.getData(nix::DataType::Int32, values.data(), {100, 4}, {500, 0});
+    CPPUNIT_ASSERT(std::all_of(values.begin(), values.begin() + 400, [](int x) { return x == 0; }));
+
+    f.flush();
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({600, 4}), stored_extent(path));
+
+    da.appendData(nix::DataType::Int32, block.data(), {10, 4}, 0);
+
+    // the ticks of an alias dimension end with the data
+    std::vector<double> ticks = {1.0, 2.0, 3.0};
+    nix::DataArray times = b.createDataArray("times", "test", ticks);
+    ticks = {4.0, 5.0};
+    times.appendData(nix::DataType::Double, ticks.data(), {2}, 0);
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({5}), times.dataExtent());
+    CPPUNIT_ASSERT(stored_extent("/data/block/data_arrays/times/data")[0] > 5);
+
+    nix::RangeDimension alias = times.appendAliasRangeDimension();
+    CPPUNIT_ASSERT_EQUAL(std::vector<double>({1.0, 2.0, 3.0, 4.0, 5.0}), alias.ticks());
+    CPPUNIT_ASSERT_EQUAL(std::vector<double>({4.0, 5.0}), alias.ticks(3, 2));
+    CPPUNIT_ASSERT_THROW(alias.ticks(4, 2), nix::OutOfBounds);
+    CPPUNIT_ASSERT_EQUAL(static_cast<nix::ndsize_t>(4), *alias.indexOf(5.0, nix::PositionMatch::Equal));
+    CPPUNIT_ASSERT_EQUAL(static_cast<nix::ndsize_t>(4), *alias.indexOf(100.0, nix::PositionMatch::LessOrEqual));
+    CPPUNIT_ASSERT(!alias.indexOf(100.0, nix::PositionMatch::GreaterOrEqual));
+
+    // also when searched on disk
+    std::shared_ptr<nix::hdf5::RangeDimensionHDF5> searched = std::dynamic_pointer_cast<nix::hdf5::RangeDimensionHDF5>(
+        times.getDimension(1).asRangeDimension().impl());
+    searched->maxCachedTicks(1);
+    CPPUNIT_ASSERT_EQUAL(static_cast<nix::ndsize_t>(5), searched->tickCount());
+    CPPUNIT_ASSERT_EQUAL(static_cast<nix::ndsize_t>(5), searched->lowerBound(100.0));
+
+    f.close();
+    CPPUNIT_ASSERT_EQUAL(nix::NDSize({610, 4}), stored_extent(path));
+}
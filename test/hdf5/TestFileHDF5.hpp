@@ -24,6 +24,10 @@ class TestFileHDF5: public BaseTestFile {
     CPPUNIT_TEST(testReopen);
     CPPUNIT_TEST(testFlags);
     CPPUNIT_TEST(testId);
+    CPPUNIT_TEST(testIdIndex);
+    CPPUNIT_TEST(testIdIndexFailure);
+    CPPUNIT_TEST(testChunkCache);
+    CPPUNIT_TEST(testGrowExtents);
     CPPUNIT_TEST_SUITE_END ();
 
 public:
@@ -32,6 +36,14 @@ public:
 
     void testVersion() override;
 
+    void testIdIndex();
+
+    void testIdIndexFailure();
+
+    void testChunkCache();
+
+    void testGrowExtents();
+
     void setUp() override {
         startup_time = time(NULL);
         file_open = nix::File::open("test_file.h5", nix::FileMode::Overwrite);
@@ -231,3 +231,60 @@ void TestH5Group::testIterOrder() {
         CPPUNIT_ASSERT_EQUAL(name, std::to_string(idx));
     }
 }
+
+void TestH5Group::testLinkIndex() {
+    nix::hdf5::H5Group root(h5group, true);
+    nix::hdf5::H5Group container = root.openGroup("indextest", true);
+
+    std::vector<std::string> ids;
+    for (int idx = 0; idx < 10; idx++) {
+        nix::hdf5::H5Group g = container.openGroup("entity_" + std::to_string(idx), true);
+        ids.push_back(nix::util::createId());
+        g.setAttr("entity_id", ids.back());
+    }
+
+    nix::hdf5::LinkIndex index;
+    for (int idx = 0; idx < 10; idx++) {
+        boost::optional<nix::hdf5::H5Group> g = index.findGroup(container, ids[idx]);
+        CPPUNIT_ASSERT(g);
+        std::string name;
+        g->getAttr("entity_id", name);
+        CPPUNIT_ASSERT_EQUAL(ids[idx], name);
+    }
+    CPPUNIT_ASSERT(!index.findGroup(container, nix::util::createId()));
+
+    // kept up to date by insert and erase
+    nix::hdf5::H5Group added = container.openGroup("added", true);
+    std::string added_id = nix::util::createId();
+    added.setAttr("entity_id", added_id);
+    index.insert(container, added_id, "added");
+    CPPUNIT_ASSERT(index.findGroup(container, added_id));
+
+    container.removeGroup("entity_0");
+    index.erase(container, ids[0]);
+    CPPUNIT_ASSERT(!index.findGroup(container, ids[0]));
+
+    // changes not reported to the index are detected
+    nix::hdf5::H5Group other = container.openGroup("other", true);
+    std::string other_id = nix::util::createId();
+    other.setAttr("entity_id", other_id);
+    CPPUNIT_ASSERT(index.findGroup(container, other_id));
+
+    container.removeGroup("entity_1");
+    CPPUNIT_ASSERT(!index.findGroup(container, ids[1]));
+    CPPUNIT_ASSERT(index.findGroup(container, ids[2]));
+
+    // an attribute that cannot be read aborts the scan with its error
+    nix::hdf5::H5Group broken = container.openGroup("broken", true);
+    broken.setAttr("entity_id", std::vector<std::string>{"a", "b"});
+    nix::hdf5::LinkIndex fresh;
+    H5E_auto2_t print;
+    void *print_data;
+    H5Eget_auto2(H5E_DEFAULT, &print, &print_data);
+    H5Eset_auto2(H5E_DEFAULT, nullptr, nullptr);
+    CPPUNIT_ASSERT_THROW(fresh.findGroup(container, ids[2]), nix::InvalidRank);
+    H5Eset_auto2(H5E_DEFAULT, print, print_data);
+
+    container.removeGroup("broken");
+    CPPUNIT_ASSERT(fresh.findGroup(container, ids[2]));
+}
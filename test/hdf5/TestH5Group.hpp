@@ -12,6 +12,7 @@
 #include <nix.hpp>
 
 #include "hdf5/h5x/H5Group.hpp"
+#include "hdf5/h5x/LinkIndex.hpp"
 
 #include <iostream>
 #include <sstream>
@@ -50,6 +51,8 @@ public:
 
     void testIterOrder();
 
+    void testLinkIndex();
+
     template<typename T>
     static void assert_vectors_equal(std::vector<T> &a, std::vector<T> &b) {
 
@@ -80,5 +83,6 @@ private:
     CPPUNIT_TEST(testMultiArray);
     CPPUNIT_TEST(testArray);
     CPPUNIT_TEST(testIterOrder);
+    CPPUNIT_TEST(testLinkIndex);
     CPPUNIT_TEST_SUITE_END ();
 };